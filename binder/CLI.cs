@@ -18,6 +18,23 @@ namespace Embeddinator
         static bool Verbose;
         static CompilationTarget Target;
         static bool DebugMode;
+        static bool GenerateSnapshots;
+        static int GenerationJobs;
+        static bool Incremental;
+        static bool ReleaseMode;
+        static string ProfileGenerateDir;
+        static string ProfileUseDir;
+        static AotMode AotMode;
+        static bool Bundle;
+        static bool LazyRuntime;
+        static bool GenerateCostReport;
+        static int CostReportThreshold = Passes.MarshalingCostPass.DefaultThreshold;
+        static bool CompactInvokers;
+        static bool GenerateDynamicInvoke;
+        static string RuntimeGcParams;
+        static string RuntimeJitOptimizations;
+        static bool RuntimeUseLlvm;
+        static bool SkipRuntimeConfig;
 
         static void ParseCommandLineArgs(string[] args)
         {
@@ -37,6 +54,24 @@ namespace Embeddinator
                 { "dll|shared", "compiles as a shared library", v => Target = CompilationTarget.SharedLibrary },
                 { "static", "compiles as a static library", v => Target = CompilationTarget.StaticLibrary },
                 { "vs=", $"Visual Studio version for compilation: {vsVersions} (defaults to Latest)", v => VsVersion = v },
+                { "release", "compiles optimized native code exporting only the bound functions", v => ReleaseMode = true },
+                { "pgo-generate=", "instruments release builds to write profile data to the given directory", v => ProfileGenerateDir = v },
+                { "pgo-use=", "optimizes release builds with the profile data in the given directory", v => ProfileUseDir = v },
+                { "aot", "ahead-of-time compiles the bound assemblies, falling back to the JIT", v => AotMode = AotMode.Normal },
+                { "full-aot", "ahead-of-time compiles the bound assemblies and disables the JIT", v => AotMode = AotMode.Full },
+                { "bundle", "embeds the bound assemblies and their AOT images in the native library (Linux)", v => Bundle = true },
+                { "lazy-runtime", "loads the Mono runtime on the first call instead of linking to it (Linux, macOS)", v => LazyRuntime = true },
+                { "snapshots", "generates snapshot functions reading all the properties of an object at once", v => GenerateSnapshots = true },
+                { "cost-report", "writes the estimated marshaling cost of each binding to embeddinator-costs.json and .txt", v => GenerateCostReport = true },
+                { "cost-threshold=", $"estimated cost at which the cost report warns about a binding (defaults to {Passes.MarshalingCostPass.DefaultThreshold})", (int v) => CostReportThreshold = v },
+                { "compact-invokers", "generates C functions calling a shared table-driven invoker, for smaller code", v => CompactInvokers = true },
+                { "dynamic-invoke", "generates tables to look up and call the C functions by name at runtime", v => GenerateDynamicInvoke = true },
+                { "gc-params=", "GC parameters the runtime is started with, as in MONO_GC_PARAMS (desktop)", v => RuntimeGcParams = v },
+                { "jit-optimize=", "JIT optimizations the runtime is started with, as in mono --optimize (desktop)", v => RuntimeJitOptimizations = v },
+                { "llvm", "compiles managed code with LLVM when the runtime supports it (desktop)", v => RuntimeUseLlvm = true },
+                { "skip-runtime-config", "starts the runtime without reading its config file or app.config", v => SkipRuntimeConfig = true },
+                { "j|jobs=", "number of assemblies generated in parallel (defaults to the processor count)", (int v) => GenerationJobs = v },
+                { "incremental", "skips generation when the inputs did not change since the last run", v => Incremental = true },
                 { "v|verbose", "generates diagnostic verbose output", v => Verbose = true },
                 { "h|help",  "show this message and exit",  v => showHelp = v != null },
             };
@@ -155,6 +190,29 @@ namespace Embeddinator
             options.CompileCode = CompileCode;
             options.Compilation.Target = Target;
             options.Compilation.DebugMode = DebugMode;
+            options.GenerateSnapshots = GenerateSnapshots;
+            options.GenerationJobs = GenerationJobs;
+            options.Incremental = Incremental;
+            options.ReleaseMode = ReleaseMode;
+            options.ProfileGenerateDir = ProfileGenerateDir;
+            options.ProfileUseDir = ProfileUseDir;
+            options.AotMode = AotMode;
+            options.Bundle = Bundle;
+            options.LazyRuntime = LazyRuntime;
+            options.GenerateCostReport = GenerateCostReport;
+            options.CostReportThreshold = CostReportThreshold;
+            options.CompactInvokers = CompactInvokers;
+            options.GenerateDynamicInvoke = GenerateDynamicInvoke;
+            options.RuntimeGcParams = RuntimeGcParams;
+            options.RuntimeJitOptimizations = RuntimeJitOptimizations;
+            options.RuntimeUseLlvm = RuntimeUseLlvm;
+            options.SkipRuntimeConfig = SkipRuntimeConfig;
+
+            if ((ProfileGenerateDir != null || ProfileUseDir != null) && !ReleaseMode)
+            {
+                Console.Error.WriteLine("Profile-guided optimization requires the release mode.");
+                return false;
+            }
 
             if (options.OutputDir == null)
                 options.OutputDir = Directory.GetCurrentDirectory();
@@ -177,10 +235,12 @@ namespace Embeddinator
                 return false;
             }
 
-            //NOTE: Choosing Java generator, needs to imply the C generator
-            if ((Generators.Contains(GeneratorKind.Java) || Generators.Contains(GeneratorKind.Swift)) &&
-                !Generators.Contains(GeneratorKind.C))
+            //NOTE: Choosing Java, Swift or C++ generators, needs to imply the C generator,
+            // which has to run first since they bind to the generated C declarations.
+            if (Generators.Contains(GeneratorKind.Java) || Generators.Contains(GeneratorKind.Swift) ||
+                Generators.Contains(GeneratorKind.CPlusPlus))
             {
+                Generators.Remove(GeneratorKind.C);
                 Generators.Insert(0, GeneratorKind.C);
             }
 
@@ -189,6 +249,19 @@ namespace Embeddinator
             var targetPlatform = ConvertToTargetPlatform(Platform);
             options.Compilation.Platform = targetPlatform;
 
+            if (Bundle && targetPlatform != TargetPlatform.Linux)
+            {
+                Console.Error.WriteLine("Bundling assemblies is only supported when targeting Linux.");
+                return false;
+            }
+
+            if (LazyRuntime && targetPlatform != TargetPlatform.Linux &&
+                targetPlatform != TargetPlatform.MacOS)
+            {
+                Console.Error.WriteLine("Loading the runtime lazily is only supported when targeting Linux or macOS.");
+                return false;
+            }
+
             var vsVersion = ConvertToVsVersion(VsVersion);
             options.Compilation.VsVersion = vsVersion;
 
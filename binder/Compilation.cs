@@ -3,6 +3,8 @@ using System.Collections.Generic;
 using System.IO;
 using System.IO.Compression;
 using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
 using System.Xml;
 using CppSharp;
 using CppSharp.Generators;
@@ -34,8 +36,7 @@ namespace Embeddinator
                 files = files.Concat(GetOutputFiles("mm"));
                 break;
             case GeneratorKind.CPlusPlus:
-                files = GetOutputFiles("c");
-                files = files.Concat(GetOutputFiles("cpp"));
+                files = GetOutputFiles("hpp");
                 break;
             case GeneratorKind.Java:
                 files = GetOutputFiles("java");
@@ -48,9 +49,17 @@ namespace Embeddinator
             if (files == null || files.Count() == 0)
                 throw new Exception("No generated files found.");
 
+            // The C++ bindings are header-only wrappers over the library built
+            // by the C generator, so there is nothing left to compile for them.
             if (Options.GeneratorKind != GeneratorKind.Java &&
-                Options.GeneratorKind != GeneratorKind.Swift)
+                Options.GeneratorKind != GeneratorKind.Swift &&
+                Options.GeneratorKind != GeneratorKind.CPlusPlus)
             {
+                // Bundled AOT images are linked into the library, so they are
+                // compiled first.
+                if (Options.AotMode != AotMode.None && !CompileAot())
+                    return false;
+
                 if (!CompileNativeCode(files))
                     return false;
             }
@@ -598,10 +607,14 @@ namespace Embeddinator
                 $"-D{DLLExportDefine}",
                 "-framework CoreFoundation",
                 $"-I\"{MonoSdkPath}/include/mono-2.0\"",
-                $"-L\"{MonoSdkPath}/lib/\" -lmonosgen-2.0",
                 string.Join(" ", files.ToList())
             };
 
+            if (Options.LazyRuntime)
+                args.Add("-DMONO_EMBEDDINATOR_LAZY_RUNTIME");
+            else
+                args.Add($"-L\"{MonoSdkPath}/lib/\" -lmonosgen-2.0");
+
             var sysroot = Path.Combine (XcodeToolchain.GetXcodeIncludesFolder (), "../..");
             args.Add ($"-isysroot {sysroot}");
 
@@ -642,6 +655,213 @@ namespace Embeddinator
                 .FirstOrDefault(File.Exists);
         }
 
+        /// <summary>
+        /// Compiles each file to an object file, in parallel. Objects are named after
+        /// a hash of the preprocessed source, the compiler and its flags, so the
+        /// files that did not change reuse the objects of a previous build.
+        /// The profile flags are left out of the hash, only the profile key is
+        /// hashed, since they name directories that differ between builds.
+        /// </summary>
+        /// <returns>The object files, or null if any of the files failed to compile.</returns>
+        static List<string> CompileObjects(string compilerBin, string compileArgs,
+            IEnumerable<string> files, string objDir, string profileArgs = null, string profileKey = null)
+        {
+            objDir = Path.GetFullPath(objDir);
+            Directory.CreateDirectory(objDir);
+
+            var sources = files.Select(Path.GetFullPath).ToList();
+            var objects = new string[sources.Count];
+            var failed = false;
+
+            var parallelOptions = new ParallelOptions
+            {
+                MaxDegreeOfParallelism = Environment.ProcessorCount
+            };
+
+            Parallel.For(0, sources.Count, parallelOptions, (i, state) =>
+            {
+                var source = sources[i];
+                var name = Path.GetFileNameWithoutExtension(source);
+
+                var preprocessed = Path.Combine(objDir, $"{name}.{i}.i");
+                var output = Invoke(compilerBin, $"{compileArgs} -E \"{source}\" -o \"{preprocessed}\"");
+                if (output.ExitCode != 0)
+                {
+                    failed = true;
+                    state.Stop();
+                    return;
+                }
+
+                string hash;
+                using (var stream = new MemoryStream())
+                {
+                    var flags = Encoding.UTF8.GetBytes($"{compilerBin}\n{compileArgs}\n{profileKey}\n");
+                    stream.Write(flags, 0, flags.Length);
+
+                    using (var file = File.OpenRead(preprocessed))
+                        file.CopyTo(stream);
+
+                    stream.Position = 0;
+                    hash = ComputeHash(stream);
+                }
+
+                File.Delete(preprocessed);
+
+                var objectFile = Path.Combine(objDir, $"{name}-{hash.Substring(0, 16)}.o");
+                objects[i] = objectFile;
+
+                if (File.Exists(objectFile))
+                {
+                    Diagnostics.Debug("Reusing: {0}", objectFile);
+                    return;
+                }
+
+                // Compile to a temporary file first so an interrupted build
+                // does not leave a truncated object behind to be reused. GCC names
+                // the profile of an object after its path, so the path does not
+                // depend on the hash and the profile of the instrumented build is
+                // found again when optimizing.
+                var tempFile = Path.Combine(objDir, $"{name}.{i}.tmp");
+                output = Invoke(compilerBin, $"{compileArgs} {profileArgs} -c \"{source}\" -o \"{tempFile}\"");
+                if (output.ExitCode != 0)
+                {
+                    failed = true;
+                    state.Stop();
+                    return;
+                }
+
+                File.Move(tempFile, objectFile);
+            });
+
+            if (failed)
+                return null;
+
+            // Remove the objects of previous builds that are not used anymore.
+            foreach (var file in Directory.EnumerateFiles(objDir, "*.o").Except(objects))
+                File.Delete(file);
+
+            return objects.ToList();
+        }
+
+        /// <summary>
+        /// Gets the GCC/Clang compiler flags of the release profile, which optimizes
+        /// the code, only exports the symbols marked with MONO_EMBEDDINATOR_API and
+        /// places each function in its own section so unused ones can be dropped.
+        /// </summary>
+        IEnumerable<string> GetReleaseCompileArgs()
+        {
+            if (!Options.ReleaseMode)
+                yield break;
+
+            yield return "-O2 -fvisibility=hidden -ffunction-sections -fdata-sections -flto";
+        }
+
+        /// <summary>
+        /// Gets the compiler flags that instrument the code or optimize it with the
+        /// given profile data. A source file without a profile fails the GCC build
+        /// instead of silently being compiled without one.
+        /// </summary>
+        IEnumerable<string> GetProfileCompileArgs(string compilerBin, string profileData)
+        {
+            if (!Options.ReleaseMode)
+                yield break;
+
+            if (!string.IsNullOrEmpty(Options.ProfileGenerateDir))
+            {
+                yield return $"-fprofile-generate=\"{Path.GetFullPath(Options.ProfileGenerateDir)}\"";
+            }
+            else if (profileData != null)
+            {
+                yield return $"-fprofile-use=\"{profileData}\"";
+
+                if (!Path.GetFileName(compilerBin).StartsWith("clang", StringComparison.Ordinal))
+                    yield return "-Werror=missing-profile";
+            }
+        }
+
+        /// <summary>
+        /// Gets the profile data to optimize with. GCC reads the .gcda files of the
+        /// profile directory as they are, while Clang needs the .profraw files of
+        /// the training runs merged with llvm-profdata first.
+        /// </summary>
+        /// <returns>The profile path to pass to the compiler, or null on errors.</returns>
+        string GetProfileData(string compilerBin)
+        {
+            var profileDir = Path.GetFullPath(Options.ProfileUseDir);
+            if (!Path.GetFileName(compilerBin).StartsWith("clang", StringComparison.Ordinal))
+                return profileDir;
+
+            var rawProfiles = Directory.Exists(profileDir) ?
+                Directory.GetFiles(profileDir, "*.profraw") : new string[0];
+            if (rawProfiles.Length == 0)
+            {
+                Diagnostics.Error("Could not find any .profraw file in '{0}'", profileDir);
+                return null;
+            }
+
+            var profdataBin = FindInPath("llvm-profdata");
+            if (profdataBin == null)
+            {
+                var siblingBin = Path.Combine(Path.GetDirectoryName(compilerBin), "llvm-profdata");
+                profdataBin = File.Exists(siblingBin) ? siblingBin : null;
+            }
+
+            if (profdataBin == null)
+            {
+                Diagnostics.Error("Could not find llvm-profdata to merge the profile data");
+                return null;
+            }
+
+            var profileData = Path.Combine(profileDir, "default.profdata");
+            var profiles = string.Join(" ", rawProfiles.Select(file => $"\"{file}\""));
+            var output = Invoke(profdataBin, $"merge -output=\"{profileData}\" {profiles}");
+            return output.ExitCode == 0 ? profileData : null;
+        }
+
+        /// <summary>
+        /// Gets the object cache key of an optimized build, which hashes the profile
+        /// data so the objects are compiled again once the profile is retrained.
+        /// </summary>
+        static string GetProfileKey(string profileData)
+        {
+            var profiles = File.Exists(profileData) ? new[] { profileData } :
+                Directory.Exists(profileData) ? Directory.GetFiles(profileData, "*.gcda", SearchOption.AllDirectories)
+                    .OrderBy(file => file, StringComparer.Ordinal).ToArray() : new string[0];
+
+            var key = new StringBuilder("use");
+            foreach (var profile in profiles)
+            {
+                using (var stream = File.OpenRead(profile))
+                    key.Append($"\n{profile}:{ComputeHash(stream)}");
+            }
+
+            return key.ToString();
+        }
+
+        /// <summary>
+        /// Gets the linker flags matching the compiler flags of the release profile.
+        /// </summary>
+        IEnumerable<string> GetReleaseLinkArgs(bool profileGuided)
+        {
+            if (!Options.ReleaseMode)
+                yield break;
+
+            // Link-time optimization needs the optimization level at link time too.
+            yield return "-O2 -flto -Wl,--gc-sections";
+
+            if (profileGuided && !string.IsNullOrEmpty(Options.ProfileGenerateDir))
+                yield return "-fprofile-generate";
+        }
+
+        void ReportLibrarySize(string path)
+        {
+            if (!Options.ReleaseMode || !File.Exists(path))
+                return;
+
+            var size = new FileInfo(path).Length;
+            Diagnostics.Message("Library size: {0} ({1:N0} bytes)", Path.GetFileName(path), size);
+        }
+
         bool CompileClangLinux(IEnumerable<string> files)
         {
             var compilerBin = FindInPath("clang") ?? FindInPath("gcc");
@@ -649,35 +869,77 @@ namespace Embeddinator
             if (compilerBin == null)
                 throw new Exception("Cannot find C++ compiler on the system.");
 
-            var args = new List<string> {
+            var compileArgs = new List<string> {
                 $"-std=gnu99 -D{DLLExportDefine}",
                 $"-D_REENTRANT -I/usr/lib/pkgconfig/../../include/mono-2.0",
-                $"-L/usr/lib/pkgconfig/../../lib -lmono-2.0 -lm -lrt -ldl -lpthread",
-                string.Join(" ", files.ToList())
             };
 
+            string profileData = null;
+            if (Options.ReleaseMode && !string.IsNullOrEmpty(Options.ProfileUseDir) &&
+                string.IsNullOrEmpty(Options.ProfileGenerateDir))
+            {
+                profileData = GetProfileData(compilerBin);
+                if (profileData == null)
+                    return false;
+            }
+
+            compileArgs.AddRange(GetReleaseCompileArgs());
+
+            var profileArgs = string.Join(" ", GetProfileCompileArgs(compilerBin, profileData));
+            var profileKey = profileArgs.Length == 0 ? null :
+                !string.IsNullOrEmpty(Options.ProfileGenerateDir) ? "generate" : GetProfileKey(profileData);
+
+            // With a lazily loaded runtime, the library does not link to it and
+            // the Mono API is called through the symbols loaded at runtime.
+            var monoLib = Options.LazyRuntime ? string.Empty : "-lmono-2.0 ";
+            if (Options.LazyRuntime)
+                compileArgs.Add("-DMONO_EMBEDDINATOR_LAZY_RUNTIME");
+
+            var linkArgs = new List<string> {
+                $"-L/usr/lib/pkgconfig/../../lib {monoLib}-lm -lrt -ldl -lpthread",
+            };
+
+            linkArgs.AddRange(GetReleaseLinkArgs(profileGuided: true));
+
+            string outputPath = null;
             if (Options.Compilation.Target == CompilationTarget.SharedLibrary)
             {
                 var name = Path.GetFileNameWithoutExtension(Project.Assemblies[0]);
                 var libName = $"lib{name}.so";
-                var outputPath = Path.Combine(Options.OutputDir, libName);
-                args.Add($"-shared -fPIC -install_name {libName} -o {outputPath}");
+                outputPath = Path.Combine(Options.OutputDir, libName);
+                compileArgs.Add("-fPIC");
+                linkArgs.Add($"-shared -fPIC -install_name {libName} -o {outputPath}");
             }
 
-            switch (Options.GeneratorKind)
+            // The C++ bindings are header-only, so only the C sources get here.
+            if (Options.GeneratorKind == GeneratorKind.ObjectiveC)
             {
-            case GeneratorKind.ObjectiveC:
-                args.Add("-ObjC");
-                args.Add("-lobjc");
-                break;
-            case GeneratorKind.CPlusPlus:
-                args.Add("-x c++");
-                break;
+                compileArgs.Add("-ObjC");
+                linkArgs.Add("-lobjc");
             }
 
-            var invocation = string.Join(" ", args);
+            if (Options.Bundle)
+                files = files.Concat(new[] { GenerateBundleSource() });
+
+            var objDir = Path.Combine(Options.OutputDir, "obj", "linux");
+            var objects = CompileObjects(compilerBin, string.Join(" ", compileArgs), files, objDir,
+                profileArgs, profileKey);
+            if (objects == null)
+                return false;
+
+            objects.AddRange(aotModuleObjects);
+
+            linkArgs.Insert(0, string.Join(" ", objects.Select(file => $"\"{file}\"")));
+
+            var invocation = string.Join(" ", linkArgs);
             var output = Invoke(compilerBin, invocation);
-            return output.ExitCode == 0;
+            if (output.ExitCode != 0)
+                return false;
+
+            if (outputPath != null)
+                ReportLibrarySize(outputPath);
+
+            return true;
         }
 
         bool CompileNDK(IEnumerable<string> files)
@@ -730,30 +992,309 @@ namespace Embeddinator
                 if (!Directory.Exists(abiDir))
                     Directory.CreateDirectory(abiDir);
 
-                var args = new List<string> {
-                    $"--sysroot=\"{systemInclude}\"{extra}",
+                var targetArgs = $"--sysroot=\"{systemInclude}\"{extra}";
+                if (isLLVM)
+                {
+                    targetArgs += $" --target={NdkUtil.GetLlvmToolchainTarget(targetArch, XamarinAndroid.ApiLevel)}";
+                }
+
+                var compileArgs = new List<string> {
+                    targetArgs,
                     "-fdiagnostics-color",
                     $"-D{DLLExportDefine}",
                     $"-I\"{monoPath}\"",
-                    $"-L\"{monoDroidPath}\" -lmonosgen-2.0 -lmono-android.release",
-                    string.Join(" ", files.ToList()),
                     "--std=c11",
                     "-fPIC",
+                };
+
+                // Profiles are collected on the host, so they are not used for the
+                // Android targets.
+                compileArgs.AddRange(GetReleaseCompileArgs());
+
+                var objDir = Path.Combine(Options.OutputDir, "obj", "android", abi);
+                var objects = CompileObjects(clangBin, string.Join(" ", compileArgs), files, objDir);
+                if (objects == null)
+                    return false;
+
+                var args = new List<string> {
+                    targetArgs,
+                    string.Join(" ", objects.Select(file => $"\"{file}\"")),
+                    $"-L\"{monoDroidPath}\" -lmonosgen-2.0 -lmono-android.release",
+                    "-fPIC",
                     $"-shared -o {outputPath}",
                 };
-                if (isLLVM)
-                {
-                    args.Add($"--target={NdkUtil.GetLlvmToolchainTarget(targetArch, XamarinAndroid.ApiLevel)}");
-                }
+
+                args.AddRange(GetReleaseLinkArgs(profileGuided: false));
 
                 var invocation = string.Join(" ", args);
                 var output = Invoke(clangBin, invocation);
                 if (output.ExitCode != 0)
                     return false;
+
+                ReportLibrarySize(outputPath);
             }
             return true;
         }
 
+        /// <summary>
+        /// Gets the bound assemblies and the dependencies found next to them.
+        /// Framework assemblies are not included, since they are provided by
+        /// the runtime along with their AOT images.
+        /// </summary>
+        List<string> GetBoundAssembliesWithDependencies()
+        {
+            var inputDirs = Project.Assemblies.Select(assembly =>
+                Path.GetDirectoryName(Path.GetFullPath(assembly))).Distinct().ToList();
+
+            var assemblies = new List<string>(Project.Assemblies.Select(Path.GetFullPath));
+
+            foreach (var reference in Assemblies.SelectMany(a => a.GetReferencedAssemblies())
+                .Select(r => r.Name).Distinct())
+            {
+                var path = inputDirs.Select(dir => Path.Combine(dir, reference + ".dll"))
+                    .FirstOrDefault(File.Exists);
+
+                if (path != null && !assemblies.Contains(path))
+                    assemblies.Add(path);
+            }
+
+            return assemblies;
+        }
+
+        /// <summary>
+        /// The extension the runtime expects for the AOT image of an assembly.
+        /// </summary>
+        string AotImageExtension
+        {
+            get
+            {
+                switch (Options.Compilation.Platform)
+                {
+                case TargetPlatform.MacOS:
+                    return ".dylib";
+                case TargetPlatform.Windows:
+                    return ".dll";
+                default:
+                    return ".so";
+                }
+            }
+        }
+
+        /// <summary>
+        /// Checks that the framework assemblies referenced by the bound ones have
+        /// full AOT images, since the JIT is not there to compile their code. The
+        /// images ship with the runtime, so they are looked up next to the framework
+        /// assemblies instead of being compiled with the bound ones.
+        /// </summary>
+        bool CheckFrameworkAotImages(List<string> assemblies)
+        {
+            var frameworkDir = Path.Combine(MonoSdkPath, "lib", "mono", "4.5");
+            var imageExtension = AotImageExtension;
+
+            var references = Assemblies.SelectMany(a => a.GetReferencedAssemblies())
+                .Select(r => r.Name)
+                .Concat(new[] { "mscorlib" })
+                .Distinct()
+                .Except(assemblies.Select(Path.GetFileNameWithoutExtension));
+
+            var found = true;
+            foreach (var reference in references)
+            {
+                var path = new[] { frameworkDir, Path.Combine(frameworkDir, "Facades") }
+                    .Select(dir => Path.Combine(dir, reference + ".dll"))
+                    .FirstOrDefault(File.Exists);
+
+                if (path == null)
+                {
+                    Diagnostics.Error("Could not find the framework assembly '{0}' in '{1}'",
+                        reference, frameworkDir);
+                    found = false;
+                }
+                else if (!File.Exists(path + imageExtension))
+                {
+                    Diagnostics.Error("Full AOT needs the AOT image of '{0}', which was not found at '{1}'",
+                        reference, path + imageExtension);
+                    found = false;
+                }
+            }
+
+            return found;
+        }
+
+        // Objects of the AOT images statically linked into the bundled library.
+        List<string> aotModuleObjects = new List<string>();
+
+        static string GetAotModuleSymbol(string assembly)
+        {
+            var name = Path.GetFileNameWithoutExtension(assembly);
+            return $"mono_aot_module_{name.Replace('.', '_').Replace('-', '_')}_info";
+        }
+
+        /// <summary>
+        /// Ahead-of-time compiles the bound assemblies and their dependencies, so
+        /// the bound methods do not need to be JIT compiled. The assemblies are
+        /// copied to the output directory along with their AOT images, where the
+        /// runtime looks for them, unless they are bundled into the library, in
+        /// which case the images are compiled to objects to be linked with it.
+        /// </summary>
+        bool CompileAot()
+        {
+            switch (Options.Compilation.Platform)
+            {
+            case TargetPlatform.Linux:
+            case TargetPlatform.MacOS:
+            case TargetPlatform.Windows:
+                break;
+            default:
+                Diagnostics.Warning("Ahead-of-time compilation is only supported on desktop platforms.");
+                return true;
+            }
+
+            var assemblies = GetBoundAssembliesWithDependencies();
+            var inputDirs = assemblies.Select(Path.GetDirectoryName).Distinct();
+
+            if (Options.AotMode == AotMode.Full && !CheckFrameworkAotImages(assemblies))
+                return false;
+
+            var executableSuffix = Platform.IsWindows ? ".exe" : string.Empty;
+            var monoBin = Path.Combine(MonoSdkPath, "bin", $"mono{executableSuffix}");
+
+            var aotArgs = string.Empty;
+            if (Options.AotMode == AotMode.Full)
+                aotArgs += "full,";
+            if (Options.Bundle)
+                aotArgs += "static,";
+
+            var envVars = new Dictionary<string, string> {
+                { "MONO_PATH", string.Join(Path.PathSeparator.ToString(), inputDirs) }
+            };
+
+            var imageExtension = AotImageExtension;
+            var aotDir = Path.Combine(Options.OutputDir, "obj", "aot");
+            if (Options.Bundle)
+                Directory.CreateDirectory(aotDir);
+
+            var objects = new string[assemblies.Count];
+            var failed = false;
+
+            var parallelOptions = new ParallelOptions
+            {
+                MaxDegreeOfParallelism = Environment.ProcessorCount
+            };
+
+            Parallel.For(0, assemblies.Count, parallelOptions, (i, state) =>
+            {
+                var assembly = assemblies[i];
+                string invocation;
+
+                if (Options.Bundle)
+                {
+                    objects[i] = Path.Combine(aotDir, Path.GetFileName(assembly) + ".o");
+                    invocation = $"--aot={aotArgs}outfile=\"{objects[i]}\" \"{assembly}\"";
+                }
+                else
+                {
+                    var outputAssembly = Path.Combine(Options.OutputDir, Path.GetFileName(assembly));
+                    if (!string.Equals(Path.GetFullPath(outputAssembly), assembly, StringComparison.Ordinal))
+                        File.Copy(assembly, outputAssembly, true);
+
+                    invocation = $"--aot={aotArgs}outfile=\"{outputAssembly}{imageExtension}\" \"{outputAssembly}\"";
+                }
+
+                var output = Invoke(monoBin, invocation, envVars);
+                if (output.ExitCode != 0)
+                {
+                    failed = true;
+                    state.Stop();
+                }
+            });
+
+            if (Options.Bundle)
+                aotModuleObjects = objects.ToList();
+
+            return !failed;
+        }
+
+        /// <summary>
+        /// Generates the source embedding the bound assemblies into the library as
+        /// read-only data, which is mapped from the library file and shared between
+        /// processes. The assemblies and the statically linked AOT modules are
+        /// registered when the library is loaded, before the runtime is initialized.
+        /// </summary>
+        string GenerateBundleSource()
+        {
+            var assemblies = GetBoundAssembliesWithDependencies();
+            var source = new StringBuilder();
+
+            source.AppendLine("// Generated by Embeddinator-4000 for bundling the managed assemblies.");
+            source.AppendLine("#include \"mono_embeddinator.h\"");
+            source.AppendLine();
+
+            for (var i = 0; i < assemblies.Count; i++)
+            {
+                var assembly = assemblies[i];
+                var symbol = $"mono_embeddinator_bundle_data_{i}";
+
+                // The hash is only there so the object cache, which is keyed on the
+                // preprocessed source, notices when the embedded file changes.
+                string hash;
+                using (var stream = File.OpenRead(assembly))
+                    hash = ComputeHash(stream);
+
+                var incbinPath = assembly.Replace('\\', '/');
+
+                source.AppendLine($"static const char {symbol}_hash[] __attribute__((unused)) = \"{hash}\";");
+                source.AppendLine("__asm__(");
+                source.AppendLine("    \".section .rodata\\n\"");
+                source.AppendLine($"    \".global {symbol}\\n\"");
+                source.AppendLine($"    \".hidden {symbol}\\n\"");
+                source.AppendLine("    \".balign 16\\n\"");
+                source.AppendLine($"    \"{symbol}:\\n\"");
+                source.AppendLine($"    \".incbin \\\"{incbinPath}\\\"\\n\"");
+                source.AppendLine("    \".previous\\n\");");
+                source.AppendLine($"extern const unsigned char {symbol}[];");
+                source.AppendLine($"static const MonoBundledAssembly mono_embeddinator_bundle_{i} = {{");
+                source.AppendLine($"    \"{Path.GetFileName(assembly)}\", {symbol}, {new FileInfo(assembly).Length}");
+                source.AppendLine("};");
+                source.AppendLine();
+            }
+
+            source.AppendLine("static const MonoBundledAssembly* mono_embeddinator_bundled_assemblies[] = {");
+            for (var i = 0; i < assemblies.Count; i++)
+                source.AppendLine($"    &mono_embeddinator_bundle_{i},");
+            source.AppendLine("    NULL");
+            source.AppendLine("};");
+            source.AppendLine();
+
+            var hasAotModules = aotModuleObjects.Count > 0;
+            if (hasAotModules)
+            {
+                foreach (var assembly in assemblies)
+                    source.AppendLine($"extern void* {GetAotModuleSymbol(assembly)};");
+                source.AppendLine();
+
+                source.AppendLine("static void** const mono_embeddinator_aot_modules[] = {");
+                foreach (var assembly in assemblies)
+                    source.AppendLine($"    &{GetAotModuleSymbol(assembly)},");
+                source.AppendLine("    NULL");
+                source.AppendLine("};");
+                source.AppendLine();
+            }
+
+            source.AppendLine("__attribute__((constructor))");
+            source.AppendLine("static void mono_embeddinator_register_bundle()");
+            source.AppendLine("{");
+            source.AppendLine("    mono_embeddinator_register_bundled_assemblies(mono_embeddinator_bundled_assemblies);");
+            if (hasAotModules)
+                source.AppendLine("    mono_embeddinator_register_aot_modules(mono_embeddinator_aot_modules);");
+            source.AppendLine("}");
+
+            var path = Path.Combine(Options.OutputDir, "mono_embeddinator_bundle.c");
+            File.WriteAllText(path, source.ToString());
+
+            return path;
+        }
+
         bool CompileNativeCode(IEnumerable<string> files)
         {
             if (Platform.IsWindows)
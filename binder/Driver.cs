@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Threading.Tasks;
 using CppSharp;
 using CppSharp.AST;
 using CppSharp.Generators;
@@ -24,6 +25,8 @@ namespace Embeddinator
 
         public ProjectOutput Output { get; private set; }
 
+        MarshalingCostPass costPass;
+
         public Driver(Project project, Options options)
         {
             Project = project;
@@ -97,6 +100,14 @@ namespace Embeddinator
                 new CheckReservedKeywords(),
             });
 
+            // The other generators bind to the C functions, so their costs are
+            // only estimated once, when generating C.
+            if (Options.GenerateCostReport && Options.GeneratorKind == GeneratorKind.C)
+            {
+                costPass = new MarshalingCostPass { Threshold = Options.CostReportThreshold };
+                Context.TranslationUnitPasses.AddPass(costPass);
+            }
+
             Context.RunPasses();
         }
 
@@ -114,6 +125,11 @@ namespace Embeddinator
                         (Path.GetExtension(file) == ".m" || file.Contains("objc")))
                         continue;
 
+                    // Skip C++ support files if we are not targetting it.
+                    if (Options.GeneratorKind != GeneratorKind.CPlusPlus &&
+                        Path.GetExtension(file) == ".hpp")
+                        continue;
+
                     Output.WriteOutput(Path.GetFileName(file), File.ReadAllText(file));
                 }
             }
@@ -127,23 +143,71 @@ namespace Embeddinator
         {
             Output = new ProjectOutput();
 
-            foreach (var unit in Context.ASTContext.TranslationUnits)
+            var units = Context.ASTContext.TranslationUnits;
+            var unitOutputs = new List<KeyValuePair<string, string>>[units.Count];
+
+            var jobs = Options.GenerationJobs > 0 ?
+                Options.GenerationJobs : Environment.ProcessorCount;
+
+            // The Java generator runs the C passes over the whole AST when creating
+            // the generators of each unit, so its units are generated one at a time.
+            if (jobs > 1 && Options.GeneratorKind != GeneratorKind.Java)
             {
-                var outputs = Generator.Generate(new[] { unit });
+                var generators = units.Select(unit => Generator.Generate(new[] { unit }))
+                    .ToList();
 
-                foreach (var output in outputs)
-                {
-                    output.Process();
-                    var text = output.Generate();
+                var parallelOptions = new ParallelOptions { MaxDegreeOfParallelism = jobs };
+                Parallel.For(0, units.Count, parallelOptions, i =>
+                    unitOutputs[i] = GenerateOutputs(generators[i]));
+            }
+            else
+            {
+                for (var i = 0; i < units.Count; i++)
+                    unitOutputs[i] = GenerateOutputs(Generator.Generate(new[] { units[i] }));
+            }
 
-                    Output.WriteOutput(output.FilePath, text);
-                }
+            // Write the outputs in unit order so the output does not depend on scheduling.
+            foreach (var outputs in unitOutputs)
+            {
+                foreach (var output in outputs)
+                    Output.WriteOutput(output.Key, output.Value);
             }
 
+            if (costPass != null)
+                GenerateCostReport();
+
             if (Options.GenerateSupportFiles)
                 GenerateSupportFiles();
         }
 
+        void GenerateCostReport()
+        {
+            Output.WriteOutput("embeddinator-costs.json", costPass.ToJson());
+            Output.WriteOutput("embeddinator-costs.txt", costPass.ToText());
+
+            costPass.WarnAboveThreshold();
+        }
+
+        /// <summary>
+        /// Processes and generates the outputs of a single unit, in the order
+        /// they were created since later ones can depend on earlier ones.
+        /// </summary>
+        static List<KeyValuePair<string, string>> GenerateOutputs(
+            IEnumerable<CodeGenerator> outputs)
+        {
+            var texts = new List<KeyValuePair<string, string>>();
+
+            foreach (var output in outputs)
+            {
+                output.Process();
+                var text = output.Generate();
+
+                texts.Add(new KeyValuePair<string, string>(output.FilePath, text));
+            }
+
+            return texts;
+        }
+
         Generator CreateGenerator()
         {
             Generator generator = null;
@@ -152,6 +216,9 @@ namespace Embeddinator
                 case GeneratorKind.C:
                     generator = new CGenerator(Context);
                     break;
+                case GeneratorKind.CPlusPlus:
+                    generator = new CppGenerator(Context);
+                    break;
                 case GeneratorKind.ObjectiveC:
                     generator = new ObjCGenerator(Context);
                     break;
@@ -188,6 +255,16 @@ namespace Embeddinator
                 var outputStream = output.Value;
                 outputStream.Position = 0;
 
+                // Leave identical files untouched so their timestamps do not
+                // trigger rebuilds of the native code depending on them.
+                if (IsFileContentEqual(fullPath, outputStream))
+                {
+                    Diagnostics.Debug("Unchanged: {0}", path);
+                    continue;
+                }
+
+                outputStream.Position = 0;
+
                 using (var outputFile = File.Create(fullPath))
                     outputStream.CopyTo(outputFile);
 
@@ -205,6 +282,42 @@ namespace Embeddinator
             return true;
         }
 
+        static bool IsFileContentEqual(string path, Stream content)
+        {
+            if (!File.Exists(path))
+                return false;
+
+            using (var file = File.OpenRead(path))
+            {
+                if (file.Length != content.Length)
+                    return false;
+
+                var fileBuffer = new byte[81920];
+                var contentBuffer = new byte[fileBuffer.Length];
+
+                int read;
+                while ((read = file.Read(fileBuffer, 0, fileBuffer.Length)) > 0)
+                {
+                    var offset = 0;
+                    while (offset < read)
+                    {
+                        var count = content.Read(contentBuffer, offset, read - offset);
+                        if (count == 0)
+                            return false;
+                        offset += count;
+                    }
+
+                    for (var i = 0; i < read; i++)
+                    {
+                        if (fileBuffer[i] != contentBuffer[i])
+                            return false;
+                    }
+                }
+
+                return true;
+            }
+        }
+
         bool ValidateAssemblies()
         {
             foreach (var assembly in Project.Assemblies)
@@ -228,23 +341,49 @@ namespace Embeddinator
 
             Project.BuildInputs();
 
-            Diagnostics.Message("Parsing assemblies...");
-            Diagnostics.PushIndent();
-            if (!Parse())
-                return false;
-            Diagnostics.PopIndent();
+            // The cache key only depends on the files of the input assemblies,
+            // so an up to date run is detected before parsing them.
+            GenerationCache cache = null;
+            if (Options.Incremental)
+                cache = GenerationCache.Load(Project, Options);
 
-            Diagnostics.Message("Processing assemblies...");
-            Diagnostics.PushIndent();
-            Process();
-            Diagnostics.PopIndent();
+            var upToDate = cache != null && cache.IsUpToDate(Options.GeneratorKinds);
 
-            Diagnostics.Message("Generating binding code...");
-            Diagnostics.PushIndent();
-            Generate();
-            if (!WriteFiles())
-                return false;
-            Diagnostics.PopIndent();
+            // Compiling needs the references of the parsed assemblies.
+            if (!upToDate || Options.CompileCode)
+            {
+                Diagnostics.Message("Parsing assemblies...");
+                Diagnostics.PushIndent();
+                if (!Parse())
+                    return false;
+                Diagnostics.PopIndent();
+            }
+
+            if (upToDate)
+            {
+                Diagnostics.Message("Binding code is up to date.");
+                Output = cache.GetOutput(Options.GeneratorKind);
+            }
+            else
+            {
+                Diagnostics.Message("Processing assemblies...");
+                Diagnostics.PushIndent();
+                Process();
+                Diagnostics.PopIndent();
+
+                Diagnostics.Message("Generating binding code...");
+                Diagnostics.PushIndent();
+                Generate();
+                if (!WriteFiles())
+                    return false;
+                Diagnostics.PopIndent();
+
+                if (cache != null)
+                {
+                    cache.Update(Options.GeneratorKind, Output);
+                    cache.Save();
+                }
+            }
 
             if (Options.CompileCode)
             {
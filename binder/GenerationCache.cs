@@ -0,0 +1,219 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using CppSharp.Generators;
+
+namespace Embeddinator
+{
+    /// <summary>
+    /// Keeps track of the files generated for a set of input assemblies and
+    /// options, so incremental runs can skip generation when nothing changed.
+    /// </summary>
+    public class GenerationCache
+    {
+        public const string FileName = ".embeddinator.cache";
+
+        /// <summary>
+        /// Hash of the binder, the input assemblies, the support files and the
+        /// options affecting the output.
+        /// </summary>
+        public string Key { get; private set; }
+
+        readonly string outputDir;
+
+        // Maps each generator to the hashes of its output files, by relative path.
+        readonly Dictionary<GeneratorKind, Dictionary<string, string>> files;
+
+        GenerationCache(string outputDir, string key)
+        {
+            this.outputDir = outputDir;
+            Key = key;
+            files = new Dictionary<GeneratorKind, Dictionary<string, string>>();
+        }
+
+        /// <summary>
+        /// Loads the cache from the output directory. The previous entries are
+        /// discarded if they were generated from different inputs.
+        /// </summary>
+        public static GenerationCache Load(Project project, Options options)
+        {
+            var cache = new GenerationCache(options.OutputDir, ComputeKey(project, options));
+
+            var path = Path.Combine(options.OutputDir, FileName);
+            if (!File.Exists(path))
+                return cache;
+
+            var lines = File.ReadAllLines(path);
+            if (lines.Length == 0 || lines[0] != $"key {cache.Key}")
+                return cache;
+
+            foreach (var line in lines.Skip(1))
+            {
+                // file <generator> <hash> <path>
+                var parts = line.Split(new[] { ' ' }, 4);
+                GeneratorKind kind;
+                if (parts.Length != 4 || parts[0] != "file" ||
+                    !Enum.TryParse(parts[1], out kind))
+                    return new GenerationCache(options.OutputDir, cache.Key);
+
+                cache.GetFiles(kind)[parts[3]] = parts[2];
+            }
+
+            return cache;
+        }
+
+        Dictionary<string, string> GetFiles(GeneratorKind kind)
+        {
+            Dictionary<string, string> hashes;
+            if (!files.TryGetValue(kind, out hashes))
+            {
+                hashes = new Dictionary<string, string>();
+                files[kind] = hashes;
+            }
+
+            return hashes;
+        }
+
+        /// <summary>
+        /// Checks that the outputs of all the given generators are in the cache
+        /// and were not modified since. All the generators of a run need to be
+        /// checked together, since the C generator feeds the ones built on it.
+        /// </summary>
+        public bool IsUpToDate(IEnumerable<GeneratorKind> kinds)
+        {
+            foreach (var kind in kinds)
+            {
+                Dictionary<string, string> hashes;
+                if (!files.TryGetValue(kind, out hashes) || hashes.Count == 0)
+                    return false;
+
+                foreach (var file in hashes)
+                {
+                    var path = Path.Combine(outputDir, file.Key);
+                    if (!File.Exists(path))
+                        return false;
+
+                    using (var stream = File.OpenRead(path))
+                    {
+                        if (Helpers.ComputeHash(stream) != file.Value)
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Reloads the previously generated outputs of a generator.
+        /// </summary>
+        public ProjectOutput GetOutput(GeneratorKind kind)
+        {
+            var output = new ProjectOutput();
+
+            foreach (var file in GetFiles(kind).Keys)
+                output.WriteOutput(file, File.ReadAllText(Path.Combine(outputDir, file)));
+
+            return output;
+        }
+
+        /// <summary>
+        /// Replaces the entries of a generator with its latest outputs.
+        /// </summary>
+        public void Update(GeneratorKind kind, ProjectOutput output)
+        {
+            var hashes = GetFiles(kind);
+            hashes.Clear();
+
+            foreach (var file in output.Files)
+            {
+                file.Value.Position = 0;
+                hashes[file.Key] = Helpers.ComputeHash(file.Value);
+            }
+        }
+
+        public void Save()
+        {
+            var lines = new List<string> { $"key {Key}" };
+
+            foreach (var generator in files.OrderBy(f => f.Key))
+            {
+                foreach (var file in generator.Value.OrderBy(f => f.Key, StringComparer.Ordinal))
+                    lines.Add($"file {generator.Key} {file.Value} {file.Key}");
+            }
+
+            Directory.CreateDirectory(outputDir);
+            File.WriteAllLines(Path.Combine(outputDir, FileName), lines);
+        }
+
+        static string ComputeKey(Project project, Options options)
+        {
+            var inputs = new List<string>
+            {
+                typeof(GenerationCache).Assembly.ManifestModule.ModuleVersionId.ToString(),
+                string.Join(",", options.GeneratorKinds),
+                options.Compilation.Platform.ToString(),
+                options.LibraryName ?? string.Empty,
+                options.UseUnmanagedThunks.ToString(),
+                options.GenerateSnapshots.ToString(),
+                options.AotMode.ToString(),
+                options.GenerateCostReport ? $"costs:{options.CostReportThreshold}" : string.Empty,
+                options.CompactInvokers.ToString(),
+                options.GenerateDynamicInvoke.ToString(),
+                $"gc:{options.RuntimeGcParams}",
+                $"jit:{options.RuntimeJitOptimizations}",
+                options.RuntimeUseLlvm.ToString(),
+                options.SkipRuntimeConfig.ToString(),
+                options.Bundle.ToString(),
+                options.LazyRuntime.ToString(),
+                options.ReleaseMode.ToString(),
+                $"pgo-generate:{options.ProfileGenerateDir}",
+                $"pgo-use:{options.ProfileUseDir}",
+            };
+
+            foreach (var assembly in project.Assemblies)
+            {
+                var path = Path.GetFullPath(assembly);
+                using (var stream = File.OpenRead(path))
+                    inputs.Add($"{path}:{Helpers.ComputeHash(stream)}");
+            }
+
+            // The support files are copied to the output, so a change to them
+            // needs to regenerate it as well.
+            string supportDir = null;
+            try
+            {
+                supportDir = Helpers.FindDirectory("support");
+            }
+            catch (Exception)
+            {
+            }
+
+            if (supportDir != null)
+            {
+                var supportFiles = Directory.GetFiles(supportDir, "*", SearchOption.AllDirectories)
+                    .OrderBy(file => file, StringComparer.Ordinal);
+
+                foreach (var file in supportFiles)
+                {
+                    using (var stream = File.OpenRead(file))
+                        inputs.Add($"{file}:{Helpers.ComputeHash(stream)}");
+                }
+            }
+
+            using (var stream = new MemoryStream())
+            {
+                using (var writer = new StreamWriter(stream))
+                {
+                    foreach (var input in inputs)
+                        writer.WriteLine(input);
+                    writer.Flush();
+
+                    stream.Position = 0;
+                    return Helpers.ComputeHash(stream);
+                }
+            }
+        }
+    }
+}
@@ -9,6 +9,28 @@ using IKVM.Reflection;
 
 namespace Embeddinator.Generators
 {
+    /// <summary>
+    /// Promises a library can make about its API with [Embeddinator.*] attributes,
+    /// which let the generators bind it with cheaper code. The attributes are
+    /// matched by name, so each library declares its own copy of them.
+    /// </summary>
+    [Flags]
+    public enum MarshalHints
+    {
+        None = 0,
+        // String parameter taking a small set of hot values, which are interned.
+        CacheableString = 1 << 0,
+        // Method which never throws, so no exception is checked after calling it.
+        NoThrow = 1 << 1,
+        // Struct only made of primitive fields, which can be passed by value.
+        Blittable = 1 << 2,
+        // Method whose result only depends on its arguments, which is memoized.
+        Pure = 1 << 3,
+        // Method or parameter which does not keep the arrays it is passed after
+        // returning, so their managed copies can be reused across calls.
+        DoesNotRetainArguments = 1 << 4
+    }
+
     public static class DeclarationExtensions
     {
         public static Declaration GetRootAssociatedDecl(this Declaration decl)
@@ -41,6 +63,23 @@ namespace Embeddinator.Generators
             // Replace + with / since that's what mono_class_from_name expects for nested types.
             return managedName.Replace("+", "/");
         }
+
+        /// <summary>
+        /// Checks if the declaration was marked with the attribute of a hint.
+        /// </summary>
+        public static bool HasHint(this Declaration decl, MarshalHints hint)
+        {
+            MarshalHints hints;
+            return ASTGenerator.Hints.TryGetValue(decl, out hints) && (hints & hint) != 0;
+        }
+
+        /// <summary>
+        /// Checks if the parameter was marked with [Embeddinator.CacheableString].
+        /// </summary>
+        public static bool IsCacheableString(this Parameter param)
+        {
+            return param.HasHint(MarshalHints.CacheableString);
+        }
     }
 
     public class ASTGenerator
@@ -56,6 +95,29 @@ namespace Embeddinator.Generators
         public static Dictionary<TranslationUnit, Assembly> ManagedAssemblies
             = new Dictionary<TranslationUnit, Assembly>();
 
+        public static Dictionary<Declaration, MarshalHints> Hints
+            = new Dictionary<Declaration, MarshalHints>();
+
+        // Fields of the structs marked with [Embeddinator.Blittable], in the
+        // order they are laid out in memory.
+        public static Dictionary<Class, List<Field>> BlittableLayouts
+            = new Dictionary<Class, List<Field>>();
+
+        // Compiler generated backing fields of non-virtual auto-properties, which
+        // can be read directly without running the property getter.
+        public static Dictionary<Declaration, string> BackingFields
+            = new Dictionary<Declaration, string>();
+
+        public static HashSet<Declaration> Delegates
+            = new HashSet<Declaration>();
+
+        // Values of const fields and of static members which always evaluate to
+        // the same literal, which are bound as constants.
+        public static Dictionary<Declaration, object> ConstantValues
+            = new Dictionary<Declaration, object>();
+
+        readonly ConstantValueReader constantValueReader = new ConstantValueReader();
+
         public ASTGenerator(ASTContext context, Options options)
         {
             ASTContext = context;
@@ -183,9 +245,18 @@ namespace Embeddinator.Generators
             if (type.IsValueType)
                 @class.Type = ClassType.ValueType;
 
+            if (type.BaseType != null && type.BaseType.FullName == "System.MulticastDelegate")
+                Delegates.Add(@class);
+
             HandleNamespace(type, @class);
             VisitMembers(type, @class);
 
+            var hints = GetHints(type.CustomAttributes);
+            var layout = hints.HasFlag(MarshalHints.Blittable) ? GetBlittableLayout(type) : null;
+            if (layout != null)
+                BlittableLayouts[@class] = layout;
+            SetHints(@class, hints, layout != null ? MarshalHints.Blittable : MarshalHints.None);
+
             if (type.BaseType != null)
                 HandleBaseType(type.BaseType, @class);
 
@@ -197,6 +268,102 @@ namespace Embeddinator.Generators
             return @class;
         }
 
+        /// <summary>
+        /// Gets the fields of a struct in memory order, or null if they are not
+        /// all primitive values laid out sequentially with natural alignment.
+        /// </summary>
+        List<Field> GetBlittableLayout(TypeInfo type)
+        {
+            if (!type.IsValueType || type.IsEnum || type.IsGenericType || !type.IsLayoutSequential)
+                return null;
+
+            var structLayout = type.StructLayoutAttribute;
+            if (structLayout != null && (structLayout.Size != 0 ||
+                (structLayout.Pack != 0 && structLayout.Pack < 8)))
+                return null;
+
+            var fields = new List<Field>();
+            foreach (var fieldInfo in type.DeclaredFields.Where(f => !f.IsStatic))
+            {
+                var fieldType = VisitType(fieldInfo.FieldType).Type;
+
+                PrimitiveType primitive;
+                Enumeration @enum;
+                if (fieldType == null)
+                    return null;
+                if (fieldType.TryGetEnum(out @enum))
+                    primitive = @enum.BuiltinType.Type;
+                else if (!fieldType.IsPrimitiveType(out primitive) ||
+                    primitive == PrimitiveType.String || primitive == PrimitiveType.Decimal ||
+                    primitive == PrimitiveType.Void || primitive == PrimitiveType.Null)
+                    return null;
+
+                // Auto-properties are exposed under the name of the property.
+                var name = fieldInfo.Name;
+                if (name.StartsWith("<", StringComparison.Ordinal) &&
+                    name.EndsWith(">k__BackingField", StringComparison.Ordinal))
+                    name = name.Substring(1, name.Length - "<>k__BackingField".Length);
+
+                fields.Add(new Field
+                {
+                    Name = name,
+                    QualifiedType = new QualifiedType(new BuiltinType(primitive))
+                });
+            }
+
+            return fields.Count > 0 ? fields : null;
+        }
+
+        static MarshalHints GetHints(IEnumerable<CustomAttributeData> attributes)
+        {
+            var hints = MarshalHints.None;
+            foreach (var attribute in attributes)
+            {
+                foreach (MarshalHints hint in Enum.GetValues(typeof(MarshalHints)))
+                {
+                    if (hint != MarshalHints.None &&
+                        attribute.AttributeType.Is("Embeddinator", $"{hint}Attribute"))
+                        hints |= hint;
+                }
+            }
+            return hints;
+        }
+
+        /// <summary>
+        /// Records the hints of a declaration, warning about the ones which do
+        /// not apply to it.
+        /// </summary>
+        static void SetHints(Declaration decl, MarshalHints hints, MarshalHints supported)
+        {
+            var unsupported = hints & ~supported;
+            if (unsupported != MarshalHints.None)
+                CppSharp.Diagnostics.Warning("Ignoring hints '{0}' which do not apply to '{1}'",
+                    unsupported, decl.Name);
+
+            hints &= supported;
+            if (hints == MarshalHints.None)
+                return;
+
+            MarshalHints existing;
+            Hints.TryGetValue(decl, out existing);
+            Hints[decl] = existing | hints;
+        }
+
+        const MarshalHints MethodHints = MarshalHints.NoThrow | MarshalHints.Pure |
+            MarshalHints.DoesNotRetainArguments;
+
+        static void SetMethodHints(Method method, MarshalHints hints)
+        {
+            SetHints(method, hints, MethodHints);
+
+            // Arguments not retained by a method are not retained by any of its parameters.
+            if (hints.HasFlag(MarshalHints.DoesNotRetainArguments))
+            {
+                foreach (var param in method.Parameters)
+                    SetHints(param, MarshalHints.DoesNotRetainArguments, MarshalHints.DoesNotRetainArguments);
+            }
+        }
+
         private void HandleNamespace(TypeInfo type, Declaration decl)
         {
             var @namespace = VisitNamespace(type);
@@ -438,6 +605,82 @@ namespace Embeddinator.Generators
             return method;
         }
 
+        static readonly string[] EnumerableTypeNames =
+        {
+            "System.Collections.Generic.IEnumerable`1",
+            "System.Collections.Generic.IList`1",
+            "System.Collections.Generic.IReadOnlyList`1"
+        };
+
+        /// <summary>
+        /// Converts a supported generic collection interface to an iterator type,
+        /// returns null if the collection or its element type is not supported.
+        /// </summary>
+        ManagedEnumerableType VisitEnumerableType(IKVM.Reflection.Type managedType)
+        {
+            if (Options.GeneratorKind != GeneratorKind.C)
+                return null;
+
+            var definition = managedType.GetGenericTypeDefinition();
+            if (!EnumerableTypeNames.Contains(definition.FullName))
+                return null;
+
+            var elementType = VisitType(managedType.GetGenericArguments()[0]);
+            if (!IsIteratorElementType(elementType.Type))
+                return null;
+
+            return new ManagedEnumerableType(elementType);
+        }
+
+        static bool IsIteratorElementType(CppSharp.AST.Type type)
+        {
+            if (type == null)
+                return false;
+
+            PrimitiveType primitive;
+            if (type.IsPrimitiveType(out primitive))
+                return primitive != PrimitiveType.Void && primitive != PrimitiveType.Null;
+
+            // Enum elements are copied as they are laid out in the managed array,
+            // which only matches the native enum size for 32-bit backing types.
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return @enum.BuiltinType.Type == PrimitiveType.Int ||
+                    @enum.BuiltinType.Type == PrimitiveType.UInt;
+
+            Class @class;
+            if (type.TryGetClass(out @class))
+                return !@class.IsValueType;
+
+            return false;
+        }
+
+        /// <summary>
+        /// Converts a Task or Task{T} to a future type, returns null if the type
+        /// is not a task or its result type is not supported.
+        /// </summary>
+        ManagedTaskType VisitTaskType(IKVM.Reflection.Type managedType)
+        {
+            if (Options.GeneratorKind != GeneratorKind.C)
+                return null;
+
+            if (managedType.FullName == "System.Threading.Tasks.Task")
+                return new ManagedTaskType(new QualifiedType(new BuiltinType(PrimitiveType.Void)));
+
+            if (!managedType.IsGenericType || managedType.GetGenericTypeDefinition().FullName !=
+                "System.Threading.Tasks.Task`1")
+                return null;
+
+            // Results are returned by value, so they need a native zero value
+            // to return when the task did not complete successfully.
+            var resultType = VisitType(managedType.GetGenericArguments()[0]);
+            if (resultType.Type == null || resultType.Type.IsPrimitiveType(PrimitiveType.Decimal) ||
+                !(resultType.Type is BuiltinType || resultType.Type is TagType))
+                return null;
+
+            return new ManagedTaskType(resultType);
+        }
+
         QualifiedType VisitType(IKVM.Reflection.Type managedType)
         {
             var isString = managedType.HasElementType && IKVM.Reflection.Type.GetTypeCode(
@@ -500,6 +743,21 @@ namespace Embeddinator.Generators
                     type = new BuiltinType(PrimitiveType.Void);
                     break;
                 }
+                if (Options.GeneratorKind == GeneratorKind.C &&
+                    managedType.FullName == "System.IO.Stream")
+                {
+                    type = new ManagedStreamType();
+                    break;
+                }
+                type = VisitTaskType(managedType);
+                if (type != null)
+                    break;
+                if (managedType.IsGenericType)
+                {
+                    type = VisitEnumerableType(managedType);
+                    if (type != null)
+                        break;
+                }
                 var currentUnit = GetTranslationUnit(CurrentAssembly);
                 if (managedType.Assembly != ManagedAssemblies[currentUnit]
                     || managedType.IsGenericType)
@@ -608,6 +866,8 @@ namespace Embeddinator.Generators
                     method.Ignore = true;
             }
 
+            SetMethodHints(method, GetHints(methodBase.CustomAttributes));
+
             method.IsStatic = methodBase.IsStatic;
             method.IsVirtual = methodBase.IsVirtual;
             method.IsPure = methodBase.IsAbstract;
@@ -659,12 +919,22 @@ namespace Embeddinator.Generators
             var type = param.QualifiedType.Type;
 
             if (type == null || (type.IsPointer() && type.GetFinalPointee() == null) ||
-                type is UnsupportedType)
+                type is UnsupportedType || type is ManagedEnumerableType ||
+                type is ManagedTaskType)
+                param.Ignore = true;
+
+            // Streams can only be passed by value.
+            if (type != null && type.IsPointer() && type.GetFinalPointee() is ManagedStreamType)
                 param.Ignore = true;
 
             if (paramInfo.ParameterType.ContainsGenericParameters)
                 param.Ignore = true;
 
+            var supportedHints = MarshalHints.DoesNotRetainArguments;
+            if (type != null && type.IsPrimitiveType(PrimitiveType.String))
+                supportedHints |= MarshalHints.CacheableString;
+            SetHints(param, GetHints(paramInfo.CustomAttributes), supportedHints);
+
             return param;
         }
 
@@ -702,12 +972,18 @@ namespace Embeddinator.Generators
                 IsStatic = fieldInfo.IsStatic
             };
 
-            if (field.Type is UnsupportedType)
+            // Iterators and futures are only supported as method and property return types.
+            if (field.Type is UnsupportedType || field.Type is ManagedEnumerableType ||
+                field.Type is ManagedTaskType)
                 field.Ignore = true;
 
             var accessMask = (fieldInfo.Attributes & FieldAttributes.FieldAccessMask);
             field.Access = ConvertFieldAttributesToAccessSpecifier(accessMask);
 
+            var value = constantValueReader.GetFieldValue(fieldInfo);
+            if (value != null)
+                ConstantValues[field] = value;
+
             ManagedNames[field] = $"{fieldInfo.DeclaringType.FullName}:{fieldInfo.Name}";
 
             return field;
@@ -735,8 +1011,20 @@ namespace Embeddinator.Generators
                 property.GetMethod = VisitMethod(propertyInfo.GetMethod);
                 property.GetMethod.Namespace = property.Namespace;
                 property.GetMethod.AssociatedDeclaration = property;
+
+                var getter = propertyInfo.GetMethod;
+                var backingFieldName = $"<{propertyInfo.Name}>k__BackingField";
+                if (!getter.IsStatic && (!getter.IsVirtual || getter.IsFinal) &&
+                    getter.HasCustomAttribute("System.Runtime.CompilerServices", "CompilerGeneratedAttribute") &&
+                    propertyInfo.DeclaringType.GetField(backingFieldName,
+                        BindingFlags.Instance | BindingFlags.NonPublic) != null)
+                    BackingFields[property] = backingFieldName;
             }
 
+            var value = constantValueReader.GetPropertyValue(propertyInfo);
+            if (value != null)
+                ConstantValues[property] = value;
+
             if (propertyInfo.SetMethod != null)
             {
                 property.SetMethod = VisitMethod(propertyInfo.SetMethod);
@@ -744,6 +1032,13 @@ namespace Embeddinator.Generators
                 property.SetMethod.AssociatedDeclaration = property;
             }
 
+            // Hints on a property apply to its accessors.
+            var propertyHints = GetHints(propertyInfo.CustomAttributes);
+            if (property.GetMethod != null)
+                SetMethodHints(property.GetMethod, propertyHints & ~MarshalHints.DoesNotRetainArguments);
+            if (property.SetMethod != null)
+                SetMethodHints(property.SetMethod, propertyHints & ~MarshalHints.Pure);
+
             ManagedNames[property] = $"{propertyInfo.DeclaringType.FullName}:{propertyInfo.Name}";
 
             return property;
@@ -787,6 +1082,24 @@ namespace Embeddinator.Generators
             return false;
         }
 
+        public static bool HasCustomAttribute (this MemberInfo self, string @namespace, string name)
+        {
+            foreach (var ca in self.CustomAttributes) {
+                if (ca.AttributeType.Is (@namespace, name))
+                    return true;
+            }
+            return false;
+        }
+
+        public static bool HasCustomAttribute (this ParameterInfo self, string @namespace, string name)
+        {
+            foreach (var ca in self.CustomAttributes) {
+                if (ca.AttributeType.Is (@namespace, name))
+                    return true;
+            }
+            return false;
+        }
+
         /// <summary>
         /// NOTE: Explicit interface implementations will be IsVirtual=True and IsFinal=True
         /// See https://msdn.microsoft.com/en-us/library/system.reflection.methodbase.isfinal(v=vs.110).aspx
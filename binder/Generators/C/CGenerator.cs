@@ -1,8 +1,12 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Globalization;
 using System.Linq;
+using System.Text;
 using CppSharp;
 using CppSharp.AST;
+using CppSharp.AST.Extensions;
 using CppSharp.Generators;
 using CppSharp.Passes;
 using Embeddinator.Passes;
@@ -118,7 +122,7 @@ namespace Embeddinator.Generators
     {
         public TranslationUnit Unit;
 
-        Options EmbedOptions => Context.Options as Options; 
+        protected Options EmbedOptions => Context.Options as Options;
 
         public CCodeGenerator(BindingContext context,
             TranslationUnit unit) : base(context, unit)
@@ -145,8 +149,9 @@ namespace Embeddinator.Generators
                 WriteLine("#include <{0}>", include);
         }
 
-        public static Dictionary<string, string> GeneratedMethodNames =
-            new Dictionary<string, string>();
+        // Units are generated concurrently, so this needs to be thread-safe.
+        public static ConcurrentDictionary<string, string> GeneratedMethodNames =
+            new ConcurrentDictionary<string, string>();
 
         public static string GetMethodIdentifier(Method method)
         {
@@ -172,6 +177,302 @@ namespace Embeddinator.Generators
             return decl.IsGenerated && !AlreadyVisited(decl);
         }
 
+        public static string GetSnapshotTypeName(Class @class) => $"{@class.QualifiedName}_Snapshot";
+
+        public static string GetSnapshotMethodName(Class @class) => $"{@class.QualifiedName}_snapshot";
+
+        /// <summary>
+        /// Gets the properties that are read by the snapshot function of a class.
+        /// </summary>
+        public static List<Property> GetSnapshotProperties(Class @class)
+        {
+            if (@class.IsStatic || @class.IsInterface)
+                return new List<Property>();
+
+            // Indexers are skipped, their getters need index arguments.
+            return @class.Properties.Where(p => p.IsGenerated && p.GetMethod != null &&
+                p.GetMethod.IsGenerated && p.GetMethod.Access == AccessSpecifier.Public &&
+                !p.GetMethod.IsStatic && p.GetMethod.Parameters.All(param => param.IsImplicit) &&
+                !(p.Type is ManagedEnumerableType) && !(p.Type is ManagedTaskType) &&
+                !(p.Type is ManagedStreamType)).ToList();
+        }
+
+        /// <summary>
+        /// Gets the name of the snapshot struct field of a property, disambiguated
+        /// the same way as the names of its accessors.
+        /// </summary>
+        public static string GetSnapshotFieldName(Property property)
+        {
+            var name = property.Name;
+
+            if (property.DefinitionOrder != 0)
+                name += $"_{property.DefinitionOrder}";
+
+            return name;
+        }
+
+        /// <summary>
+        /// Gets the task type returned by a method, if it has a result that
+        /// needs a generated result accessor.
+        /// </summary>
+        public static ManagedTaskType GetTaskResultType(Method method)
+        {
+            var task = method.ReturnType.Type as ManagedTaskType;
+            return (task != null && task.HasResult) ? task : null;
+        }
+
+        public static string GetTaskResultMethodName(Method method) =>
+            $"{GetMethodIdentifier(method)}_result";
+
+        public void GenerateTaskResultMethodSpecifier(Method method)
+        {
+            var task = GetTaskResultType(method);
+            var retType = task.ResultType.Visit(CTypePrinter);
+
+            Write($"{retType} {GetTaskResultMethodName(method)}(MonoEmbedFuture* future)");
+        }
+
+        /// <summary>
+        /// Checks if a method returns a string, and so also gets a variant
+        /// returning a view over the UTF-16 characters of the string.
+        /// </summary>
+        public static bool HasStringViewMethod(Method method) =>
+            !method.IsConstructor && method.ReturnType.Type.IsPrimitiveType(PrimitiveType.String);
+
+        public static string GetStringViewMethodName(Method method) =>
+            $"{GetMethodIdentifier(method)}_view";
+
+        public void GenerateStringViewMethodSpecifier(Method method)
+        {
+            Write($"MonoEmbedStringView {GetStringViewMethodName(method)}(");
+            Write(CTypePrinter.VisitParameters(method.Parameters));
+            Write(")");
+        }
+
+        /// <summary>
+        /// Gets the struct a type refers to if it was marked with [Embeddinator.Blittable],
+        /// and so can also be passed by value with the layout of its managed fields.
+        /// </summary>
+        public static Class GetBlittableStruct(CppSharp.AST.Type type)
+        {
+            Class @class;
+            if (type == null || !type.TryGetClass(out @class))
+                return null;
+
+            return ASTGenerator.BlittableLayouts.ContainsKey(@class) ? @class : null;
+        }
+
+        public static bool IsBlittableValue(Parameter param) =>
+            !param.IsImplicit && param.Usage == ParameterUsage.In && GetBlittableStruct(param.Type) != null;
+
+        public static string GetValueTypeName(Class @class) => $"{@class.QualifiedName}_Value";
+
+        /// <summary>
+        /// Checks if a method takes or returns blittable structs, and so also gets
+        /// a variant passing them by value instead of as object handles.
+        /// </summary>
+        public static bool HasValueMethod(Method method) =>
+            !method.IsConstructor && (GetBlittableStruct(method.ReturnType.Type) != null ||
+                method.Parameters.Any(IsBlittableValue));
+
+        public static string GetValueMethodName(Method method) =>
+            $"{GetMethodIdentifier(method)}_value";
+
+        public void GenerateValueMethodSpecifier(Method method)
+        {
+            var @struct = GetBlittableStruct(method.ReturnType.Type);
+            var retType = @struct != null ? GetValueTypeName(@struct) :
+                method.ReturnType.Visit(CTypePrinter).ToString();
+
+            var @params = method.Parameters.Select(p => IsBlittableValue(p) ?
+                $"{GetValueTypeName(GetBlittableStruct(p.Type))} {p.Name}" :
+                CTypePrinter.VisitParameter(p).ToString());
+
+            Write($"{retType} {GetValueMethodName(method)}({string.Join(", ", @params)})");
+        }
+
+        /// <summary>
+        /// Checks if the result of a method marked with [Embeddinator.Pure] can be
+        /// memoized, which needs its arguments and result to be plain values.
+        /// </summary>
+        public static bool IsMemoizable(Method method)
+        {
+            if (!method.HasHint(MarshalHints.Pure) || method.IsConstructor || !method.IsStatic)
+                return false;
+
+            return IsMemoizableValue(method.ReturnType.Type) && method.Parameters.All(p =>
+                p.Usage == ParameterUsage.In && IsMemoizableValue(p.Type));
+        }
+
+        static bool IsMemoizableValue(CppSharp.AST.Type type)
+        {
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return true;
+
+            PrimitiveType primitive;
+            return type.IsPrimitiveType(out primitive) && primitive != PrimitiveType.String &&
+                primitive != PrimitiveType.Decimal && primitive != PrimitiveType.Void &&
+                primitive != PrimitiveType.Null;
+        }
+
+        /// <summary>
+        /// Gets the property a method is the getter of, if the property always
+        /// evaluates to the same literal and so is also bound as a constant.
+        /// </summary>
+        public static Property GetConstantProperty(Method method)
+        {
+            var property = method.AssociatedDeclaration as Property;
+            if (property == null || property.GetMethod != method)
+                return null;
+
+            object value;
+            return TryGetConstantValue(property, out value) ? property : null;
+        }
+
+        public static bool TryGetConstantValue(Property property, out object value)
+        {
+            var decl = (Declaration)property.Field ?? property;
+            return ASTGenerator.ConstantValues.TryGetValue(decl, out value);
+        }
+
+        public static string GetConstantName(Property property) =>
+            $"{(property.Namespace as Class).QualifiedName}_{property.Name}";
+
+        public string GetConstantLiteral(Property property)
+        {
+            object value;
+            TryGetConstantValue(property, out value);
+
+            var literal = GetLiteral(value);
+
+            Enumeration @enum;
+            if (property.Type.TryGetEnum(out @enum))
+                return $"(({property.QualifiedType.Visit(CTypePrinter)}) {literal})";
+
+            return literal;
+        }
+
+        static string GetLiteral(object value)
+        {
+            if (value is string)
+                return GetStringLiteral((string)value);
+
+            if (value is bool)
+                return (bool)value ? "true" : "false";
+
+            string literal;
+            if (value is float || value is double)
+            {
+                literal = value is float ? ((float)value).ToString("R", CultureInfo.InvariantCulture) :
+                    ((double)value).ToString("R", CultureInfo.InvariantCulture);
+                if (literal.IndexOfAny(new[] { '.', 'E' }) < 0)
+                    literal += ".0";
+                if (value is float)
+                    literal += "f";
+            }
+            else if (value is ulong || value is uint)
+                literal = Convert.ToUInt64(value).ToString(CultureInfo.InvariantCulture) +
+                    (value is ulong ? "ULL" : "U");
+            else if (value is long)
+                literal = (long)value == long.MinValue ? "-9223372036854775807LL - 1" :
+                    ((long)value).ToString(CultureInfo.InvariantCulture) + "LL";
+            else
+            {
+                var integer = Convert.ToInt64(value);
+                literal = integer == int.MinValue ? "-2147483647 - 1" : integer.ToString(CultureInfo.InvariantCulture);
+            }
+
+            return literal.StartsWith("-", StringComparison.Ordinal) ? $"({literal})" : literal;
+        }
+
+        // Encodes a string as UTF-8, using octal escapes since hexadecimal
+        // ones would also consume the digits following them.
+        public static string GetStringLiteral(string value)
+        {
+            var literal = new StringBuilder("\"");
+            foreach (var b in Encoding.UTF8.GetBytes(value))
+            {
+                if (b == '"' || b == '\\' || b == '?')
+                    literal.Append('\\').Append((char)b);
+                else if (b >= 0x20 && b < 0x7F)
+                    literal.Append((char)b);
+                else
+                    literal.Append('\\').Append(Convert.ToString(b, 8).PadLeft(3, '0'));
+            }
+
+            return literal.Append('"').ToString();
+        }
+
+        /// <summary>
+        /// Number of native functions that can be bound at the same time
+        /// to each delegate type.
+        /// </summary>
+        public const int CallbackSlotCount = 16;
+
+        /// <summary>
+        /// Gets the Invoke method of a delegate class if its signature can be
+        /// bound to a native callback, or null otherwise.
+        /// </summary>
+        public static Method GetCallbackInvokeMethod(Class @class)
+        {
+            if (!ASTGenerator.Delegates.Contains(@class))
+                return null;
+
+            var invoke = @class.Methods.FirstOrDefault(m => m.Name == "Invoke" && m.IsGenerated);
+            if (invoke == null || !IsCallbackType(invoke.ReturnType.Type, isReturn: true))
+                return null;
+
+            if (invoke.Parameters.Where(p => !p.IsImplicit).Any(p =>
+                p.Usage != ParameterUsage.In || !IsCallbackType(p.Type, isReturn: false)))
+                return null;
+
+            return invoke;
+        }
+
+        // Only types laid out the same way by the runtime's native to managed
+        // wrappers and by the generated headers can cross a callback.
+        static bool IsCallbackType(CppSharp.AST.Type type, bool isReturn)
+        {
+            PrimitiveType primitive;
+            if (type.IsPrimitiveType(out primitive))
+            {
+                switch (primitive)
+                {
+                case PrimitiveType.Void:
+                    return isReturn;
+                case PrimitiveType.String:
+                    return !isReturn;
+                case PrimitiveType.SChar:
+                case PrimitiveType.UChar:
+                case PrimitiveType.Short:
+                case PrimitiveType.UShort:
+                case PrimitiveType.Int:
+                case PrimitiveType.UInt:
+                case PrimitiveType.Long:
+                case PrimitiveType.ULong:
+                case PrimitiveType.Float:
+                case PrimitiveType.Double:
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return @enum.BuiltinType.Type == PrimitiveType.Int ||
+                    @enum.BuiltinType.Type == PrimitiveType.UInt;
+
+            return false;
+        }
+
+        public static string GetCallbackTypeName(Class @class) => $"{@class.QualifiedName}_fn";
+
+        public static string GetCallbackNewMethodName(Class @class) => $"{@class.QualifiedName}_new_callback";
+
+        public static string GetCallbackReleaseMethodName(Class @class) => $"{@class.QualifiedName}_release_callback";
+
         public override void GenerateMethodSpecifier(Method method, Class @class)
         {
             var retType = method.ReturnType.Visit(CTypePrinter);
@@ -1,4 +1,5 @@
-﻿using System.Linq;
+﻿using System;
+using System.Linq;
 using CppSharp;
 using CppSharp.AST;
 using CppSharp.Generators;
@@ -59,6 +60,8 @@ namespace Embeddinator.Generators
 
             WriteForwardDecls();
 
+            GenerateBlittableStructs();
+
             VisitDeclContext(Unit);
 
             PushBlock();
@@ -83,6 +86,34 @@ namespace Embeddinator.Generators
                     decl.Visit(this);
         }
 
+        /// <summary>
+        /// Declares the structs marked with [Embeddinator.Blittable] with the layout
+        /// of their managed fields, for the functions passing them by value.
+        /// </summary>
+        public void GenerateBlittableStructs()
+        {
+            var layouts = ASTGenerator.BlittableLayouts
+                .Where(l => l.Key.TranslationUnit == TranslationUnit && l.Key.IsGenerated)
+                .OrderBy(l => l.Key.QualifiedName, StringComparer.Ordinal);
+
+            foreach (var layout in layouts)
+            {
+                PushBlock();
+
+                var valueName = GetValueTypeName(layout.Key);
+                WriteLine($"typedef struct {valueName}");
+                WriteStartBraceIndent();
+
+                foreach (var field in layout.Value)
+                    WriteLine($"{field.QualifiedType.Visit(CTypePrinter)} {field.Name};");
+
+                PopIndent();
+                WriteLine($"}} {valueName};");
+
+                PopBlock(NewLineKind.BeforeNextBlock);
+            }
+        }
+
         public override bool VisitDeclContext(DeclarationContext context)
         {
             foreach (var decl in context.Declarations.Where(d => !(d is Enumeration)))
@@ -150,9 +181,67 @@ namespace Embeddinator.Generators
 
             PopBlock(NewLineKind.BeforeNextBlock);
 
+            var invoke = GetCallbackInvokeMethod(@class);
+            if (invoke != null)
+                GenerateCallbackDeclarations(@class, invoke);
+
+            if (EmbedOptions.GenerateSnapshots)
+                GenerateClassSnapshot(@class);
+
             return true;
         }
 
+        public void GenerateCallbackDeclarations(Class @class, Method invoke)
+        {
+            PushBlock();
+
+            var typeName = @class.Visit(CTypePrinter);
+            var callbackName = GetCallbackTypeName(@class);
+
+            var @params = invoke.Parameters.Where(p => !p.IsImplicit).ToList();
+            var paramsList = CTypePrinter.VisitParameters(@params, hasNames: true).ToString();
+            if (@params.Count > 0)
+                paramsList += ", ";
+
+            var contextName = @params.Any(p => p.Name == "context") ? "user_context" : "context";
+            WriteLine($"typedef {invoke.ReturnType.Visit(CTypePrinter)} (*{callbackName})" +
+                $"({paramsList}void* {contextName});");
+            NewLine();
+
+            Write("MONO_EMBEDDINATOR_API ");
+            WriteLine($"{typeName}* {GetCallbackNewMethodName(@class)}({callbackName} fn, void* context);");
+
+            Write("MONO_EMBEDDINATOR_API ");
+            WriteLine($"void {GetCallbackReleaseMethodName(@class)}({typeName}* object);");
+
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        public void GenerateClassSnapshot(Class @class)
+        {
+            var properties = GetSnapshotProperties(@class);
+            if (properties.Count == 0)
+                return;
+
+            PushBlock();
+
+            var snapshotName = GetSnapshotTypeName(@class);
+            WriteLine($"typedef struct {snapshotName}");
+            WriteStartBraceIndent();
+
+            foreach (var property in properties)
+                WriteLine($"{property.GetMethod.ReturnType.Visit(CTypePrinter)} {GetSnapshotFieldName(property)};");
+
+            PopIndent();
+            WriteLine($"}} {snapshotName};");
+            NewLine();
+
+            Write("MONO_EMBEDDINATOR_API ");
+            WriteLine($"void {GetSnapshotMethodName(@class)}({@class.Visit(CTypePrinter)}* object, {snapshotName}* out);");
+
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
         public override bool VisitMethodDecl(Method method)
         {
             if (!VisitDeclaration(method))
@@ -164,6 +253,31 @@ namespace Embeddinator.Generators
             GenerateMethodSpecifier(method, method.Namespace as Class);
             WriteLine(";");
 
+            if (GetTaskResultType(method) != null)
+            {
+                Write("MONO_EMBEDDINATOR_API ");
+                GenerateTaskResultMethodSpecifier(method);
+                WriteLine(";");
+            }
+
+            if (HasStringViewMethod(method))
+            {
+                Write("MONO_EMBEDDINATOR_API ");
+                GenerateStringViewMethodSpecifier(method);
+                WriteLine(";");
+            }
+
+            if (HasValueMethod(method))
+            {
+                Write("MONO_EMBEDDINATOR_API ");
+                GenerateValueMethodSpecifier(method);
+                WriteLine(";");
+            }
+
+            var constant = GetConstantProperty(method);
+            if (constant != null)
+                WriteLine($"#define {GetConstantName(constant)} {GetConstantLiteral(constant)}");
+
             PopBlock();
 
             return true;
@@ -14,6 +14,12 @@ namespace Embeddinator.Generators
 
         public Options Options => Context.Options as Options;
 
+        /// <summary>
+        /// Releases what the Before code acquired. Unlike the After code, it also
+        /// runs when a constructor throws and returns early.
+        /// </summary>
+        public TextGenerator Cleanup = new TextGenerator();
+
         public bool IsByRefParameter => (Parameter != null) &&
             (Parameter.IsOut || Parameter.IsInOut);
 
@@ -26,6 +32,54 @@ namespace Embeddinator.Generators
             return true;
         }
 
+        /// <summary>
+        /// Checks if arrays of a type have the same layout in managed and native
+        /// code, so their elements can be copied in bulk.
+        /// </summary>
+        public static bool IsBlittableArrayElement(Type type)
+        {
+            PrimitiveType primitive;
+            if (!type.IsPrimitiveType(out primitive))
+                return false;
+
+            switch (primitive)
+            {
+            case PrimitiveType.SChar:
+            case PrimitiveType.UChar:
+            case PrimitiveType.Short:
+            case PrimitiveType.UShort:
+            case PrimitiveType.Int:
+            case PrimitiveType.UInt:
+            case PrimitiveType.Long:
+            case PrimitiveType.ULong:
+            case PrimitiveType.LongLong:
+            case PrimitiveType.ULongLong:
+            case PrimitiveType.Float:
+            case PrimitiveType.Double:
+                return true;
+            }
+
+            return false;
+        }
+
+        public virtual bool VisitManagedEnumerableType(ManagedEnumerableType enumerable,
+            TypeQualifiers quals)
+        {
+            return true;
+        }
+
+        public virtual bool VisitManagedTaskType(ManagedTaskType task,
+            TypeQualifiers quals)
+        {
+            return true;
+        }
+
+        public virtual bool VisitManagedStreamType(ManagedStreamType stream,
+            TypeQualifiers quals)
+        {
+            return true;
+        }
+
         public override bool VisitDecayedType(DecayedType decayed,
             TypeQualifiers quals)
         {
@@ -33,6 +87,18 @@ namespace Embeddinator.Generators
             if (managedArray != null)
                 return VisitManagedArrayType(managedArray, quals);
 
+            var managedEnumerable = decayed as ManagedEnumerableType;
+            if (managedEnumerable != null)
+                return VisitManagedEnumerableType(managedEnumerable, quals);
+
+            var managedTask = decayed as ManagedTaskType;
+            if (managedTask != null)
+                return VisitManagedTaskType(managedTask, quals);
+
+            var managedStream = decayed as ManagedStreamType;
+            if (managedStream != null)
+                return VisitManagedStreamType(managedStream, quals);
+
             return VisitDecayedType(decayed, quals);
         }
     }
@@ -50,6 +116,9 @@ namespace Embeddinator.Generators
         public override bool VisitManagedArrayType(ManagedArrayType array,
             TypeQualifiers quals)
         {
+            if (!IsByRefParameter && IsBlittableArrayElement(array.Array.Type))
+                return MarshalBlittableArray(array);
+
             var arrayId = CGenerator.GenId($"{ArgName}_array");
             Before.WriteLine("MonoArray* {0} = (MonoArray*) {1};",
                                             arrayId, ArgName);
@@ -124,6 +193,73 @@ namespace Embeddinator.Generators
             return false;
         }
 
+        bool MarshalBlittableArray(ManagedArrayType array)
+        {
+            var arrayId = CGenerator.GenId($"{ArgName}_array");
+            Before.WriteLine("MonoArray* {0} = (MonoArray*) {1};", arrayId, ArgName);
+
+            CTypePrinter.PrintScopeKind = TypePrintScopeKind.Local;
+            var arrayTypedefName = array.Typedef.Visit(CTypePrinter);
+
+            CTypePrinter.PrintScopeKind = TypePrintScopeKind.Qualified;
+            var elementSize = $"sizeof({array.Array.Type.Visit(CTypePrinter)})";
+
+            var nativeArrayId = CGenerator.GenId($"{ArgName}_native_array");
+            Before.WriteLine("{0} {1};", arrayTypedefName, nativeArrayId);
+            Before.WriteLine("{0}.array = 0;", nativeArrayId);
+
+            Before.WriteLine("if ({0})", arrayId);
+            Before.WriteStartBraceIndent();
+
+            var arraySizeId = CGenerator.GenId($"{ArgName}_array_size");
+            Before.WriteLine("uintptr_t {0} = mono_array_length({1});",
+                arraySizeId, arrayId);
+            Before.WriteLine("{0}.array = g_array_sized_new(/*zero_terminated=*/FALSE," +
+                " /*clear_=*/FALSE, {1}, {2});", nativeArrayId, elementSize, arraySizeId);
+            Before.WriteLine("g_array_append_vals({0}.array, mono_array_addr_with_size({1}, {2}, 0), {3});",
+                nativeArrayId, arrayId, elementSize, arraySizeId);
+
+            Before.WriteCloseBraceIndent();
+
+            Return.Write("{0}", nativeArrayId);
+            return false;
+        }
+
+        public override bool VisitManagedEnumerableType(ManagedEnumerableType enumerable,
+            TypeQualifiers quals)
+        {
+            var elementType = enumerable.ElementType.Type;
+
+            var elementClassId = CGenerator.GenId($"{ArgName}_element_class");
+            Before.WriteLine("MonoClass* {0} = {1};", elementClassId,
+                CMarshalNativeToManaged.GenerateArrayTypeLookup(elementType, Before));
+
+            var kind = "MONO_EMBEDDINATOR_ITERATOR_VALUE";
+            if (elementType.IsPrimitiveType(PrimitiveType.String))
+                kind = "MONO_EMBEDDINATOR_ITERATOR_STRING";
+            else if (elementType.IsClass())
+                kind = "MONO_EMBEDDINATOR_ITERATOR_OBJECT";
+
+            Return.Write("mono_embeddinator_iterator_new({0}, {1}, {2})",
+                ArgName, elementClassId, kind);
+            return true;
+        }
+
+        public override bool VisitManagedTaskType(ManagedTaskType task,
+            TypeQualifiers quals)
+        {
+            Return.Write("mono_embeddinator_future_new({0}, {1})", ArgName,
+                task.HasResult ? "true" : "false");
+            return true;
+        }
+
+        public override bool VisitManagedStreamType(ManagedStreamType stream,
+            TypeQualifiers quals)
+        {
+            Return.Write("mono_embeddinator_stream_new({0})", ArgName);
+            return true;
+        }
+
         public override bool VisitEnumDecl(Enumeration @enum)
         {
             VisitPrimitiveType(@enum.BuiltinType.Type);
@@ -224,6 +360,12 @@ namespace Embeddinator.Generators
     {
         public bool PrimitiveValuesByValue { get; set; }
 
+        /// <summary>
+        /// Set when blittable structs are passed as native values laid out like
+        /// their managed fields, instead of as object handles.
+        /// </summary>
+        public bool BlittableStructsByValue { get; set; }
+
         public CMarshalNativeToManaged (BindingContext context)
             : base (context)
         {
@@ -249,13 +391,13 @@ namespace Embeddinator.Generators
                 case PrimitiveType.UShort:
                     return "mono_get_uint16_class()";
                 case PrimitiveType.Int:
-                case PrimitiveType.Long:
                     return "mono_get_int32_class()";
-                case PrimitiveType.ULong:
                 case PrimitiveType.UInt:
                     return "mono_get_uint32_class()";
+                case PrimitiveType.Long:
                 case PrimitiveType.LongLong:
                     return "mono_get_int64_class()";
+                case PrimitiveType.ULong:
                 case PrimitiveType.ULongLong:
                     return "mono_get_uint64_class()";
                 case PrimitiveType.Float:
@@ -347,6 +489,41 @@ namespace Embeddinator.Generators
 
             var managedArray = array.Array;
             var elementType = managedArray.Type;
+
+            if (!IsByRefParameter && IsBlittableArrayElement(elementType))
+            {
+                var elementSize = $"sizeof({elementType.Visit(CTypePrinter)})";
+
+                Before.WriteLine("MonoArray* {0} = 0;", arrayId);
+                Before.WriteLine("if ({0}.array)", ArgName);
+                Before.WriteStartBraceIndent();
+                Before.WriteLine("MonoClass* {0} = mono_class_get_element_class({1});",
+                    elementClassId, GenerateArrayTypeLookup(elementType, Before));
+
+                // Arrays not retained by the callee are lent from the ones of previous
+                // calls, which avoids allocating a managed array on each call.
+                if (Parameter != null && Parameter.HasHint(MarshalHints.DoesNotRetainArguments))
+                {
+                    Before.WriteLine("{0} = mono_embeddinator_array_lend({1}.domain, {2}, {3}.array->len, {4});",
+                        arrayId, contextId, elementClassId, ArgName, ParameterIndex);
+
+                    Cleanup.WriteLine("if ({0}.array)", ArgName);
+                    Cleanup.WriteLineIndent("mono_embeddinator_array_return({0});", ParameterIndex);
+                }
+                else
+                {
+                    Before.WriteLine("{0} = mono_array_new({1}.domain, {2}, {3}.array->len);",
+                        arrayId, contextId, elementClassId, ArgName);
+                }
+
+                Before.WriteLine("memcpy(mono_array_addr_with_size({0}, {1}, 0), {2}.array->data, {2}.array->len * {1});",
+                    arrayId, elementSize, ArgName);
+                Before.WriteCloseBraceIndent();
+
+                Return.Write("{0}", arrayId);
+                return true;
+            }
+
             Before.WriteLine("MonoClass* {0} = mono_class_get_element_class({1});",
                 elementClassId, GenerateArrayTypeLookup(elementType, Before));
 
@@ -422,6 +599,13 @@ namespace Embeddinator.Generators
             return true;
         }
 
+        public override bool VisitManagedStreamType(ManagedStreamType stream,
+            TypeQualifiers quals)
+        {
+            Return.Write("mono_embeddinator_stream_get_object({0})", ArgName);
+            return true;
+        }
+
         public override bool VisitEnumDecl(Enumeration @enum)
         {
             var byValue = PrimitiveValuesByValue ? string.Empty : "&";
@@ -436,6 +620,12 @@ namespace Embeddinator.Generators
 
         public override bool VisitClassDecl(Class @class)
         {
+            if (BlittableStructsByValue && Parameter != null && CCodeGenerator.IsBlittableValue(Parameter))
+            {
+                Return.Write($"&{ArgName}");
+                return true;
+            }
+
             var arg = IsByRefParameter ? $"(*{ArgName})" : ArgName;
             var handle = CSources.GetMonoObjectField(Options, CSources.MonoObjectFieldUsage.Parameter,
                 arg, "_handle");
@@ -578,6 +768,13 @@ namespace Embeddinator.Generators
                         After.WriteLine("mono_embeddinator_marshal_string_to_gstring({0}, {1});",
                             ArgName, argId);
                     }
+                    else if (Parameter != null && Parameter.IsCacheableString())
+                    {
+                        Before.WriteLine("MonoString* {0} = mono_embeddinator_string_cache_lookup({1}.domain, {2});",
+                            argId, contextId, @string);
+                        Return.Write("{0}", argId);
+                        return true;
+                    }
 
                     Before.WriteLine("MonoString* {0} = ({2}) ? mono_string_new({1}.domain, {2}) : 0;",
                         argId, contextId, @string);
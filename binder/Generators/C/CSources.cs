@@ -18,8 +18,6 @@ namespace Embeddinator.Generators
 
         public override string FileExtension => "c";
 
-        Options EmbedOptions => Options as Options;
-
         public override void WriteHeaders()
         {
             WriteLine("#include \"{0}.h\"", Unit.FileNameWithoutExtension);
@@ -28,15 +26,8 @@ namespace Embeddinator.Generators
             WriteInclude("c-support.h");
         }
 
-        void RemoveTypedefNodes()
-        {
-            Unit.Declarations.RemoveAll(d => d is TypedefDecl);
-        }
-
         public override void Process()
         {
-            RemoveTypedefNodes();
-
             GenerateFilePreamble(CommentKind.BCPL, "Embeddinator-4000");
 
             PushBlock();
@@ -53,6 +44,9 @@ namespace Embeddinator.Generators
             GenerateGlobalMethods();
 
             VisitDeclContext(Unit);
+
+            if (invokerMethods.Count > 0)
+                GenerateInvokerMethods();
         }
 
         public virtual void GenerateGlobalMethods()
@@ -66,6 +60,12 @@ namespace Embeddinator.Generators
             return true;
         }
 
+        public override bool VisitTypedefDecl(TypedefDecl typedef)
+        {
+            // Typedefs are only declared in the header.
+            return true;
+        }
+
         public override bool VisitClassDecl(Class @class)
         {
             if (!VisitDeclaration(@class))
@@ -75,9 +75,261 @@ namespace Embeddinator.Generators
 
             VisitDeclContext(@class);
 
+            var invoke = GetCallbackInvokeMethod(@class);
+            if (invoke != null)
+                GenerateCallbacks(@class, invoke);
+
+            if (EmbedOptions.GenerateSnapshots)
+                GenerateClassSnapshot(@class);
+
             return true;
         }
 
+        /// <summary>
+        /// Generates a pool of trampolines binding native functions and their context
+        /// to instances of a delegate type, and the functions to acquire and release them.
+        /// </summary>
+        public void GenerateCallbacks(Class @class, Method invoke)
+        {
+            var className = @class.QualifiedName.Replace('.', '_');
+            var typeName = @class.Visit(CTypePrinter);
+            var callbackName = GetCallbackTypeName(@class);
+            var slotsId = GeneratedIdentifier($"{className}_callback_slots");
+            var trampolinesId = GeneratedIdentifier($"{className}_trampolines");
+            var poolId = GeneratedIdentifier($"{className}_callback_pool");
+
+            PushBlock();
+            WriteLine($"static mono_embeddinator_callback_slot_t {slotsId}[{CallbackSlotCount}];");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            var @params = invoke.Parameters.Where(p => !p.IsImplicit).ToList();
+            var paramsList = CTypePrinter.VisitParameters(@params, hasNames: true).ToString();
+            var returnType = invoke.ReturnType.Visit(CTypePrinter);
+            var needsReturn = !invoke.ReturnType.Type.IsPrimitiveType(PrimitiveType.Void);
+
+            for (var i = 0; i < CallbackSlotCount; i++)
+            {
+                PushBlock();
+                WriteLine($"static {returnType} MONO_EMBEDDINATOR_CALLBACK " +
+                    $"{GeneratedIdentifier($"{className}_trampoline_{i}")}({paramsList})");
+                WriteStartBraceIndent();
+
+                var args = @params.Select(p => p.Name).Concat(new[] { $"{slotsId}[{i}].context" });
+                WriteLine($"{(needsReturn ? "return " : string.Empty)}(({callbackName}) {slotsId}[{i}].fn)" +
+                    $"({string.Join(", ", args)});");
+
+                WriteCloseBraceIndent();
+                PopBlock(NewLineKind.BeforeNextBlock);
+            }
+
+            PushBlock();
+            WriteLine($"static void* {trampolinesId}[{CallbackSlotCount}] =");
+            WriteStartBraceIndent();
+            for (var i = 0; i < CallbackSlotCount; i++)
+                WriteLine($"(void*) {GeneratedIdentifier($"{className}_trampoline_{i}")},");
+            PopIndent();
+            WriteLine("};");
+            NewLine();
+            WriteLine($"static mono_embeddinator_callback_pool_t {poolId} = " +
+                $"{{ {slotsId}, {trampolinesId}, {CallbackSlotCount} }};");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"{typeName}* {GetCallbackNewMethodName(@class)}({callbackName} fn, void* context)");
+            WriteStartBraceIndent();
+
+            var classId = $"class_{@class.QualifiedName}";
+            var delegateId = GeneratedIdentifier("delegate");
+            WriteLine($"{GeneratedIdentifier($"lookup_class_{className}")}();");
+            WriteLine($"MonoObject* {delegateId} = mono_embeddinator_callback_acquire(&{poolId}, " +
+                $"{classId}, (void*) fn, context);");
+            WriteLine($"if (!{delegateId})");
+            WriteLineIndent("return 0;");
+            NewLine();
+            WriteLine($"return ({typeName}*) mono_embeddinator_create_object({delegateId});");
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"void {GetCallbackReleaseMethodName(@class)}({typeName}* object)");
+            WriteStartBraceIndent();
+
+            WriteLine("if (!object)");
+            WriteLineIndent("return;");
+            NewLine();
+
+            var handle = GetMonoObjectField(Options, MonoObjectFieldUsage.Parameter, "object", "_handle");
+            WriteLine($"mono_embeddinator_callback_release(&{poolId}, mono_gchandle_get_target({handle}));");
+            WriteLine("mono_embeddinator_destroy_object(object);");
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        /// <summary>
+        /// Generates a function reading all the public readable properties of an object
+        /// into a snapshot struct. Field and auto-property backing storage is read directly
+        /// without running any managed code, only the remaining getters are invoked.
+        /// If a getter throws, the values already read are released before the
+        /// exception is reported.
+        /// </summary>
+        public void GenerateClassSnapshot(Class @class)
+        {
+            var properties = GetSnapshotProperties(@class);
+            if (properties.Count == 0)
+                return;
+
+            PushBlock();
+
+            var snapshotMethodName = GetSnapshotMethodName(@class);
+            var gettersId = GeneratedIdentifier($"{snapshotMethodName}_getters");
+            var fieldsId = GeneratedIdentifier($"{snapshotMethodName}_fields");
+            var initializedId = GeneratedIdentifier($"{snapshotMethodName}_initialized");
+            var initId = GeneratedIdentifier($"{snapshotMethodName}_init");
+            WriteLine($"static MonoMethod* {gettersId}[{properties.Count}];");
+            WriteLine($"static MonoClassField* {fieldsId}[{properties.Count}];");
+            WriteLine($"static mono_embeddinator_init_flag_t {initializedId};");
+            NewLine();
+
+            var classId = $"class_{@class.QualifiedName}";
+            var classLookupId = GeneratedIdentifier($"lookup_class_{@class.QualifiedName.Replace('.', '_')}");
+
+            WriteLine($"static void {initId}()");
+            WriteStartBraceIndent();
+            WriteLine($"{classLookupId}();");
+
+            var fieldNames = properties.Select(GetSnapshotBackingFieldName).ToList();
+            for (var i = 0; i < properties.Count; i++)
+            {
+                if (fieldNames[i] != null)
+                    WriteLine($"{fieldsId}[{i}] = mono_class_get_field_from_name({classId}, \"{fieldNames[i]}\");");
+                else
+                    WriteLine($"{gettersId}[{i}] = mono_embeddinator_lookup_method(" +
+                        $"\"{properties[i].GetMethod.ManagedQualifiedName()}\", {classId});");
+            }
+
+            WriteCloseBraceIndent();
+            NewLine();
+
+            var objectId = FixMethodParametersPass.ObjectParameterId;
+            WriteLine($"void {snapshotMethodName}({@class.Visit(CTypePrinter)}* {objectId}, " +
+                $"{GetSnapshotTypeName(@class)}* out)");
+            WriteStartBraceIndent();
+
+            WriteLine($"mono_embeddinator_init_once(&{initializedId}, {initId});");
+            NewLine();
+
+            var instanceId = GeneratedIdentifier("instance");
+            var handle = GetMonoObjectField(Options, MonoObjectFieldUsage.Parameter, objectId, "_handle");
+            WriteLine($"MonoObject* {instanceId} = mono_gchandle_get_target({handle});");
+
+            var thisId = instanceId;
+            if (@class.IsValueType)
+            {
+                thisId = GeneratedIdentifier("unboxed");
+                WriteLine($"void* {thisId} = mono_object_unbox({instanceId});");
+            }
+
+            var domainId = $"{GeneratedIdentifier("mono_context")}.domain";
+            var resultId = GeneratedIdentifier("result");
+
+            for (var i = 0; i < properties.Count; i++)
+            {
+                var property = properties[i];
+                var retType = property.GetMethod.ReturnType;
+
+                NewLine();
+                WriteStartBraceIndent();
+
+                if (fieldNames[i] != null)
+                {
+                    if (retType.Type.IsPrimitiveType() && !retType.Type.IsPrimitiveType(PrimitiveType.String))
+                    {
+                        WriteLine($"mono_field_get_value({instanceId}, {fieldsId}[{i}], &out->{GetSnapshotFieldName(property)});");
+                        WriteCloseBraceIndent();
+                        continue;
+                    }
+
+                    WriteLine($"MonoObject* {resultId} = mono_field_get_value_object({domainId}, {fieldsId}[{i}], {instanceId});");
+                }
+                else
+                {
+                    var methodId = $"{gettersId}[{i}]";
+                    if (property.GetMethod.IsVirtual)
+                        methodId = $"mono_object_get_virtual_method({instanceId}, {methodId})";
+
+                    var exceptionId = GeneratedIdentifier("exception");
+                    WriteLine($"MonoObject* {exceptionId} = 0;");
+                    WriteLine($"MonoObject* {resultId} = mono_runtime_invoke({methodId}, {thisId}, 0, &{exceptionId});");
+                    WriteLine($"if ({exceptionId})");
+                    WriteStartBraceIndent();
+
+                    for (var j = 0; j < i; j++)
+                    {
+                        var free = GetSnapshotFieldFree(properties[j]);
+                        if (free != null)
+                            WriteLine(free);
+                    }
+
+                    WriteLine($"mono_embeddinator_throw_exception({exceptionId});");
+                    WriteLine("return;");
+                    WriteCloseBraceIndent();
+                }
+
+                var marshal = new CMarshalManagedToNative(Context)
+                {
+                    ArgName = resultId,
+                    ReturnVarName = resultId,
+                    ReturnType = retType
+                };
+
+                retType.Visit(marshal);
+
+                if (!string.IsNullOrWhiteSpace(marshal.Before))
+                    Write(marshal.Before);
+
+                WriteLine($"out->{GetSnapshotFieldName(property)} = {marshal.Return};");
+                WriteCloseBraceIndent();
+            }
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        /// <summary>
+        /// Gets the statement releasing the value read into the snapshot field of a
+        /// property, or null if the value does not own any memory.
+        /// </summary>
+        static string GetSnapshotFieldFree(Property property)
+        {
+            var field = $"out->{GetSnapshotFieldName(property)}";
+            var type = property.GetMethod.ReturnType.Type;
+
+            if (type.IsPrimitiveType(PrimitiveType.String))
+                return $"mono_embeddinator_string_free({field});";
+
+            if (type is ManagedArrayType)
+                return $"mono_embeddinator_array_free({field});";
+
+            if (type.IsClass())
+                return $"mono_embeddinator_destroy_object((MonoEmbedObject*) {field});";
+
+            return null;
+        }
+
+        static string GetSnapshotBackingFieldName(Property property)
+        {
+            if (property.Field != null)
+                return property.Field.ManagedQualifiedName().Split(':').Last();
+
+            string backingField;
+            if (ASTGenerator.BackingFields.TryGetValue(property, out backingField))
+                return backingField;
+
+            return null;
+        }
+
         public void GenerateObjectDeclarations()
         {
             var referencedClasses = new GetReferencedDecls();
@@ -109,13 +361,48 @@ namespace Embeddinator.Generators
             WriteLine($"if ({contextId}.domain)");
             WriteLineIndent("return;");
 
+            switch (EmbedOptions.AotMode)
+            {
+            case AotMode.Normal:
+                WriteLine("mono_embeddinator_set_aot_mode(MONO_EMBEDDINATOR_AOT_NORMAL);");
+                break;
+            case AotMode.Full:
+                WriteLine("mono_embeddinator_set_aot_mode(MONO_EMBEDDINATOR_AOT_FULL);");
+                break;
+            }
+
             var domainName = "mono_embeddinator_binding";
-            WriteLine($"mono_embeddinator_init(&{contextId}, \"{domainName}\");");
+
+            if (EmbedOptions.HasRuntimeOptions)
+                GenerateInitWithOptions(contextId, domainName);
+            else
+                WriteLine($"mono_embeddinator_init(&{contextId}, \"{domainName}\");");
 
             WriteCloseBraceIndent();
             PopBlock(NewLineKind.BeforeNextBlock);
         }
 
+        void GenerateInitWithOptions(string contextId, string domainName)
+        {
+            var optionsId = GeneratedIdentifier("init_options");
+            WriteLine($"mono_embeddinator_init_options_t {optionsId} = {{ 0 }};");
+            WriteLine($"{optionsId}.domain = \"{domainName}\";");
+
+            if (EmbedOptions.RuntimeGcParams != null)
+                WriteLine($"{optionsId}.gc_params = {GetStringLiteral(EmbedOptions.RuntimeGcParams)};");
+
+            if (EmbedOptions.RuntimeJitOptimizations != null)
+                WriteLine($"{optionsId}.jit_optimizations = {GetStringLiteral(EmbedOptions.RuntimeJitOptimizations)};");
+
+            if (EmbedOptions.RuntimeUseLlvm)
+                WriteLine($"{optionsId}.use_llvm = true;");
+
+            if (EmbedOptions.SkipRuntimeConfig)
+                WriteLine($"{optionsId}.skip_config = true;");
+
+            WriteLine($"mono_embeddinator_init_with_options(&{contextId}, &{optionsId});");
+        }
+
         public void GenerateAssemblyLoad()
         {
             var assemblyName = Unit.FileName;
@@ -254,6 +541,9 @@ namespace Embeddinator.Generators
             }
         }
 
+        // Set while generating the variants of methods taking blittable structs by value.
+        bool blittableStructsByValue;
+
         public void GenerateMethodInvocation(Method method)
         {
             GenerateMethodInitialization(method);
@@ -270,7 +560,7 @@ namespace Embeddinator.Generators
                 WriteLine($"void* {argsId}[{numParamsToMarshal}];");
             }
 
-            var marshalers = new List<Marshaler>();
+            var marshalers = new List<CMarshaler>();
 
             int paramIndex = 0;
             foreach (var param in paramsToMarshal)
@@ -279,23 +569,31 @@ namespace Embeddinator.Generators
                 {
                     ArgName = param.Name,
                     Parameter = param,
-                    ParameterIndex = paramIndex
+                    ParameterIndex = paramIndex++,
+                    BlittableStructsByValue = blittableStructsByValue
                 };
                 marshalers.Add(marshal);
 
                 param.Visit(marshal);
+            }
 
+            foreach (var marshal in marshalers)
+            {
                 if (!string.IsNullOrWhiteSpace(marshal.Before))
                     Write(marshal.Before);
 
-                WriteLine($"{argsId}[{paramIndex++}] = {marshal.Return};");
+                WriteLine($"{argsId}[{marshal.ParameterIndex}] = {marshal.Return};");
                 NeedNewLine();
             }
 
             NewLineIfNeeded();
 
+            // Methods marked with [Embeddinator.NoThrow] are not passed an exception slot.
+            var noThrow = method.HasHint(MarshalHints.NoThrow);
+
             var exceptionId = GeneratedIdentifier("exception");
-            WriteLine($"MonoObject* {exceptionId} = 0;");
+            if (!noThrow)
+                WriteLine($"MonoObject* {exceptionId} = 0;");
 
             var methodId = GeneratedIdentifier("method");
             var instanceId = method.IsStatic ? "0" : GeneratedIdentifier("instance");
@@ -316,23 +614,36 @@ namespace Embeddinator.Generators
             }
 
             Write($"MonoObject* {GeneratedIdentifier("result")} = ");
-            WriteLine($"mono_runtime_invoke({methodId}, {instanceId}, {argsId}, &{exceptionId});");
+            var exceptionArg = noThrow ? "0" : $"&{exceptionId}";
+            WriteLine($"mono_runtime_invoke({methodId}, {instanceId}, {argsId}, {exceptionArg});");
 
-            NewLine();
-            WriteLine($"if ({exceptionId})");
-
-            if (method.IsConstructor)
+            if (!noThrow)
             {
-                WriteLine("{");
-                WriteLineIndent($"free({GeneratedIdentifier("object")});");
-            }
+                NewLine();
+                WriteLine($"if ({exceptionId})");
+
+                if (method.IsConstructor)
+                {
+                    WriteLine("{");
+                    PushIndent();
+                    WriteLine($"free({GeneratedIdentifier("object")});");
 
-            WriteLineIndent($"mono_embeddinator_throw_exception({exceptionId});");
+                    foreach (var marshal in marshalers)
+                    {
+                        if (!string.IsNullOrWhiteSpace(marshal.Cleanup))
+                            Write(marshal.Cleanup);
+                    }
 
-            if (method.IsConstructor)
-            {
-                WriteLineIndent("return 0;");
-                WriteLine("}");
+                    PopIndent();
+                }
+
+                WriteLineIndent($"mono_embeddinator_throw_exception({exceptionId});");
+
+                if (method.IsConstructor)
+                {
+                    WriteLineIndent("return 0;");
+                    WriteLine("}");
+                }
             }
 
             NeedNewLine();
@@ -344,6 +655,12 @@ namespace Embeddinator.Generators
                     NewLineIfNeeded();
                     Write(marshal.After);
                 }
+
+                if (!string.IsNullOrWhiteSpace(marshal.Cleanup))
+                {
+                    NewLineIfNeeded();
+                    Write(marshal.Cleanup);
+                }
             }
         }
 
@@ -352,12 +669,34 @@ namespace Embeddinator.Generators
             if (!VisitDeclaration(method))
                 return false;
 
+            var compact = IsCompactInvocation(method);
+            if (compact || (EmbedOptions.GenerateDynamicInvoke && IsInvokable(method)))
+                invokerMethods.Add(method);
+
+            if (compact)
+            {
+                compactMethods.Add(method);
+                GenerateCompanionMethods(method);
+                return true;
+            }
+
             PushBlock();
 
             GenerateMethodSpecifier(method, method.Namespace as Class);
             NewLine();
             WriteStartBraceIndent();
 
+            if (GenerateConstantReturn(method))
+            {
+                WriteCloseBraceIndent();
+                PopBlock(NewLineKind.BeforeNextBlock);
+                return true;
+            }
+
+            var memoize = IsMemoizable(method);
+            if (memoize)
+                GenerateMemoLookup(method);
+
             GenerateMethodLookup(method);
             NewLine();
 
@@ -394,7 +733,12 @@ namespace Embeddinator.Generators
                 returnCode = GeneratedIdentifier("object");
             }
 
-            if (method.IsConstructor || needsReturn)
+            if (memoize)
+            {
+                NewLine();
+                GenerateMemoStore(method, returnCode);
+            }
+            else if (method.IsConstructor || needsReturn)
             {
                 NewLine();
                 WriteLine("return {0};", returnCode);
@@ -403,9 +747,420 @@ namespace Embeddinator.Generators
             WriteCloseBraceIndent();
             PopBlock(NewLineKind.BeforeNextBlock);
 
+            GenerateCompanionMethods(method);
+
             return true;
         }
 
+        void GenerateCompanionMethods(Method method)
+        {
+            if (GetTaskResultType(method) != null)
+                GenerateTaskResultMethod(method);
+
+            if (HasStringViewMethod(method))
+                GenerateStringViewMethod(method);
+
+            if (HasValueMethod(method))
+                GenerateValueMethod(method);
+        }
+
+        // Must match MONO_EMBEDDINATOR_INVOKE_MAX_PARAMS in c-support.h.
+        const int InvokeMaxParams = 16;
+
+        // Methods with an invoker descriptor, in the order of their descriptors.
+        readonly List<Method> invokerMethods = new List<Method>();
+
+        // Methods generated as calls to the shared invoker.
+        readonly HashSet<Method> compactMethods = new HashSet<Method>();
+
+        /// <summary>
+        /// Gets the kind the shared invoker marshals a parameter or result type
+        /// as, or null if it can only be marshaled by expanded code.
+        /// </summary>
+        static string GetInvokeKind(CppSharp.AST.Type type, Parameter param)
+        {
+            // Arrays, collections, streams and tasks.
+            if (type is DecayedType)
+                return null;
+
+            PrimitiveType primitive;
+            if (type.IsPrimitiveType(out primitive))
+            {
+                switch (primitive)
+                {
+                case PrimitiveType.Void:
+                    return param == null ? "MONO_EMBEDDINATOR_KIND_VOID" : null;
+                case PrimitiveType.String:
+                    return param != null && param.IsCacheableString() ?
+                        "MONO_EMBEDDINATOR_KIND_CACHED_STRING" : "MONO_EMBEDDINATOR_KIND_STRING";
+                default:
+                    return "MONO_EMBEDDINATOR_KIND_VALUE";
+                }
+            }
+
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return "MONO_EMBEDDINATOR_KIND_VALUE";
+
+            Class @class;
+            if (type.TryGetClass(out @class))
+                return GetInvokeKind(@class);
+
+            return null;
+        }
+
+        static string GetInvokeKind(Class @class)
+        {
+            if (ASTGenerator.Delegates.Contains(@class))
+                return null;
+
+            return @class.IsValueType ? "MONO_EMBEDDINATOR_KIND_STRUCT" : "MONO_EMBEDDINATOR_KIND_OBJECT";
+        }
+
+        static string GetInvokeReturnKind(Method method)
+        {
+            return method.IsConstructor ? GetInvokeKind(method.Namespace as Class) :
+                GetInvokeKind(method.ReturnType.Type, null);
+        }
+
+        string GetInvokeReturnType(Method method)
+        {
+            return method.IsConstructor ? $"{method.Namespace.Visit(CTypePrinter)}*" :
+                method.ReturnType.Visit(CTypePrinter).ToString();
+        }
+
+        /// <summary>
+        /// Checks if a method can be called by the shared invoker, which needs all
+        /// its parameters to be passed by value and to have an invoker kind.
+        /// </summary>
+        bool IsInvokable(Method method)
+        {
+            if (Options.GeneratorKind != GeneratorKind.C)
+                return false;
+
+            var @params = method.Parameters.Where(p => !p.IsImplicit).ToList();
+            return @params.Count <= InvokeMaxParams &&
+                @params.All(p => p.Usage == ParameterUsage.In && GetInvokeKind(p.Type, p) != null) &&
+                GetInvokeReturnKind(method) != null;
+        }
+
+        /// <summary>
+        /// Checks if a method is generated as a call to the shared invoker.
+        /// </summary>
+        bool IsCompactInvocation(Method method)
+        {
+            if (!EmbedOptions.CompactInvokers)
+                return false;
+
+            if (IsMemoizable(method) || GetConstantProperty(method) != null)
+                return false;
+
+            return IsInvokable(method);
+        }
+
+        /// <summary>
+        /// Generates the descriptor table of the methods called through the shared
+        /// invoker, the functions only passing it their arguments and the table
+        /// looking them up by name.
+        /// </summary>
+        void GenerateInvokerMethods()
+        {
+            var methodsId = GeneratedIdentifier("methods");
+
+            PushBlock();
+            for (var i = 0; i < invokerMethods.Count; i++)
+            {
+                var @params = invokerMethods[i].Parameters.Where(p => !p.IsImplicit).ToList();
+                if (@params.Count == 0)
+                    continue;
+
+                var kinds = @params.Select(p => GetInvokeKind(p.Type, p));
+                WriteLine($"static const uint8_t {GeneratedIdentifier($"method_kinds_{i}")}[] = " +
+                    $"{{ {string.Join(", ", kinds)} }};");
+            }
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"static mono_embeddinator_method_desc_t {methodsId}[] =");
+            WriteStartBraceIndent();
+            for (var i = 0; i < invokerMethods.Count; i++)
+            {
+                var method = invokerMethods[i];
+                var @class = method.Namespace as Class;
+                var paramCount = method.Parameters.Count(p => !p.IsImplicit);
+                var kindsId = paramCount > 0 ? GeneratedIdentifier($"method_kinds_{i}") : "0";
+
+                var returnKind = GetInvokeReturnKind(method);
+                var returnSize = returnKind == "MONO_EMBEDDINATOR_KIND_VALUE" ?
+                    $"sizeof({GetInvokeReturnType(method)})" : "0";
+
+                var flags = new List<string>();
+                if (method.IsConstructor)
+                    flags.Add("MONO_EMBEDDINATOR_INVOKE_CONSTRUCTOR");
+                else if (!method.IsStatic)
+                    flags.Add("MONO_EMBEDDINATOR_INVOKE_INSTANCE");
+                if (method.IsVirtual)
+                    flags.Add("MONO_EMBEDDINATOR_INVOKE_VIRTUAL");
+                if (@class.IsValueType && !method.IsStatic)
+                    flags.Add("MONO_EMBEDDINATOR_INVOKE_VALUE_TYPE");
+                if (method.HasHint(MarshalHints.NoThrow))
+                    flags.Add("MONO_EMBEDDINATOR_INVOKE_NO_THROW");
+
+                var classLookupId = GeneratedIdentifier($"lookup_class_{@class.QualifiedName.Replace('.', '_')}");
+                WriteLine($"{{ 0, {kindsId}, {paramCount}, {returnKind}, {returnSize}, " +
+                    $"{(flags.Count > 0 ? string.Join(" | ", flags) : "0")}, " +
+                    $"\"{method.ManagedQualifiedName()}\", &class_{@class.QualifiedName}, {classLookupId} }},");
+            }
+            PopIndent();
+            WriteLine("};");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            for (var i = 0; i < invokerMethods.Count; i++)
+            {
+                var method = invokerMethods[i];
+                if (!compactMethods.Contains(method))
+                    continue;
+
+                PushBlock();
+                GenerateMethodSpecifier(method, method.Namespace as Class);
+                NewLine();
+                WriteStartBraceIndent();
+
+                var needsReturn = method.IsConstructor ||
+                    !method.ReturnType.Type.IsPrimitiveType(PrimitiveType.Void);
+                var resultId = GeneratedIdentifier("result");
+                if (needsReturn)
+                    WriteLine($"{GetInvokeReturnType(method)} {resultId};");
+
+                var @params = method.Parameters.Where(p => !p.IsImplicit).ToList();
+                var argsId = "0";
+                if (@params.Count > 0)
+                {
+                    argsId = GeneratedIdentifier("args");
+                    WriteLine($"void* {argsId}[] = {{ {string.Join(", ", @params.Select(p => $"&{p.Name}"))} }};");
+                }
+
+                var instance = method.IsStatic || method.IsConstructor ? "0" : method.Parameters[0].Name;
+                WriteLine($"mono_embeddinator_invoke(&{methodsId}[{i}], {instance}, {argsId}, " +
+                    $"{(needsReturn ? $"&{resultId}" : "0")});");
+
+                if (needsReturn)
+                    WriteLine($"return {resultId};");
+
+                WriteCloseBraceIndent();
+                PopBlock(NewLineKind.BeforeNextBlock);
+            }
+
+            if (EmbedOptions.GenerateDynamicInvoke)
+                GenerateDynamicTable();
+        }
+
+        /// <summary>
+        /// Generates the perfect hash table looking up the functions of the unit
+        /// by name, and registers it when the library is loaded.
+        /// </summary>
+        void GenerateDynamicTable()
+        {
+            var methodsId = GeneratedIdentifier("methods");
+            var entriesId = GeneratedIdentifier("dynamic_entries");
+            var displacementsId = GeneratedIdentifier("dynamic_displacements");
+            var tableId = GeneratedIdentifier("dynamic_table");
+
+            var indices = invokerMethods.Select((m, i) => new { Name = GetMethodIdentifier(m), Index = i })
+                .ToDictionary(m => m.Name, m => m.Index);
+            var table = PerfectHashTable.Build(indices.Keys.ToList());
+
+            PushBlock();
+            WriteLine($"static const mono_embeddinator_dynamic_entry_t {entriesId}[] =");
+            WriteStartBraceIndent();
+            foreach (var name in table.Slots)
+                WriteLine($"{{ \"{name}\", (void (*)()) {name}, &{methodsId}[{indices[name]}] }},");
+            PopIndent();
+            WriteLine("};");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"static const int32_t {displacementsId}[] = {{ {string.Join(", ", table.Displacements)} }};");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"static mono_embeddinator_dynamic_table_t {tableId} = " +
+                $"{{ {entriesId}, {displacementsId}, {table.Slots.Length}, 0 }};");
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            PushBlock();
+            WriteLine($"MONO_EMBEDDINATOR_CONSTRUCTOR({CGenerator.AssemblyId(Unit)}_register_dynamic_table)");
+            WriteStartBraceIndent();
+            WriteLine($"mono_embeddinator_register_dynamic_table(&{tableId});");
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        /// <summary>
+        /// Returns the result of the previous call of a method marked with
+        /// [Embeddinator.Pure] on the same thread if it had the same arguments.
+        /// </summary>
+        void GenerateMemoLookup(Method method)
+        {
+            var memoId = GeneratedIdentifier("memo");
+
+            WriteLine("static MONO_EMBEDDINATOR_THREAD_LOCAL struct");
+            WriteStartBraceIndent();
+            WriteLine("bool valid;");
+            foreach (var param in method.Parameters)
+                WriteLine($"{param.Type.Visit(CTypePrinter)} arg_{param.Name};");
+            WriteLine($"{method.ReturnType.Visit(CTypePrinter)} result;");
+            PopIndent();
+            WriteLine($"}} {memoId};");
+            NewLine();
+
+            var conditions = new List<string> { $"{memoId}.valid" };
+            conditions.AddRange(method.Parameters.Select(p =>
+                $"memcmp(&{memoId}.arg_{p.Name}, &{p.Name}, sizeof({p.Name})) == 0"));
+
+            WriteLine($"if ({string.Join(" && ", conditions)})");
+            WriteLineIndent($"return {memoId}.result;");
+            NewLine();
+        }
+
+        void GenerateMemoStore(Method method, string returnCode)
+        {
+            var memoId = GeneratedIdentifier("memo");
+
+            WriteLine($"{memoId}.result = {returnCode};");
+            foreach (var param in method.Parameters)
+                WriteLine($"{memoId}.arg_{param.Name} = {param.Name};");
+            WriteLine($"{memoId}.valid = true;");
+            WriteLine($"return {memoId}.result;");
+        }
+
+        public void GenerateValueMethod(Method method)
+        {
+            PushBlock();
+
+            GenerateValueMethodSpecifier(method);
+            NewLine();
+            WriteStartBraceIndent();
+
+            GenerateMethodLookup(method);
+            NewLine();
+
+            blittableStructsByValue = true;
+            GenerateMethodInvocation(method);
+            blittableStructsByValue = false;
+
+            var retType = method.ReturnType;
+            var resultId = GeneratedIdentifier("result");
+            var @struct = GetBlittableStruct(retType.Type);
+
+            if (@struct != null)
+            {
+                var valueName = GetValueTypeName(@struct);
+
+                NewLine();
+                WriteLine($"if (!{resultId})");
+                WriteStartBraceIndent();
+                WriteLine($"{valueName} {GeneratedIdentifier("empty")} = {{ 0 }};");
+                WriteLine($"return {GeneratedIdentifier("empty")};");
+                WriteCloseBraceIndent();
+                NewLine();
+                WriteLine($"return *({valueName}*) mono_object_unbox({resultId});");
+            }
+            else if (!retType.Type.IsPrimitiveType(PrimitiveType.Void))
+            {
+                var marshal = new CMarshalManagedToNative(Context)
+                {
+                    ArgName = resultId,
+                    ReturnVarName = resultId,
+                    ReturnType = retType
+                };
+
+                retType.Visit(marshal);
+
+                NewLineIfNeeded();
+
+                if (!string.IsNullOrWhiteSpace(marshal.Before))
+                    Write(marshal.Before);
+
+                NewLine();
+                WriteLine($"return {marshal.Return};");
+            }
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        /// <summary>
+        /// Returns the value of a constant without calling into the runtime. Strings
+        /// are still read from it, since callers own the copy they are returned.
+        /// </summary>
+        bool GenerateConstantReturn(Method method)
+        {
+            var property = GetConstantProperty(method);
+            if (property == null || property.Type.IsPrimitiveType(PrimitiveType.String))
+                return false;
+
+            WriteLine($"return {GetConstantName(property)};");
+            return true;
+        }
+
+        public void GenerateStringViewMethod(Method method)
+        {
+            PushBlock();
+
+            GenerateStringViewMethodSpecifier(method);
+            NewLine();
+            WriteStartBraceIndent();
+
+            GenerateMethodLookup(method);
+            NewLine();
+
+            GenerateMethodInvocation(method);
+
+            NewLine();
+            WriteLine("return mono_embeddinator_string_view_new((MonoString*) {0});",
+                GeneratedIdentifier("result"));
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        public void GenerateTaskResultMethod(Method method)
+        {
+            PushBlock();
+
+            GenerateTaskResultMethodSpecifier(method);
+            NewLine();
+            WriteStartBraceIndent();
+
+            var resultId = GeneratedIdentifier("result");
+            WriteLine($"MonoObject* {resultId} = mono_embeddinator_future_get_result(future);");
+            WriteLine($"if (!{resultId})");
+            WriteLineIndent("return 0;");
+            NewLine();
+
+            var resultType = GetTaskResultType(method).ResultType;
+            var marshal = new CMarshalManagedToNative(Context)
+            {
+                ArgName = resultId,
+                ReturnVarName = resultId,
+                ReturnType = resultType
+            };
+
+            resultType.Visit(marshal);
+
+            if (!string.IsNullOrWhiteSpace(marshal.Before))
+            {
+                Write(marshal.Before);
+                NewLine();
+            }
+
+            WriteLine("return {0};", marshal.Return);
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
         public void GenerateFieldLookup(Field field)
         {
             var fieldId = GeneratedIdentifier("field");
@@ -460,6 +1215,12 @@ namespace Embeddinator.Generators
             NewLine();
             WriteStartBraceIndent();
 
+            if (GenerateConstantReturn(getter))
+            {
+                WriteCloseBraceIndent();
+                return;
+            }
+
             var field = property.Field;
             GenerateFieldLookup(field);
 
@@ -24,6 +24,15 @@ namespace Embeddinator.Generators
             if (managedArray != null)
                 return managedArray.Typedef.Visit(this);
 
+            if (decayed is ManagedEnumerableType)
+                return "MonoEmbedIterator*";
+
+            if (decayed is ManagedTaskType)
+                return "MonoEmbedFuture*";
+
+            if (decayed is ManagedStreamType)
+                return "MonoEmbedStream*";
+
             return base.VisitDecayedType(decayed, quals);
         }
 
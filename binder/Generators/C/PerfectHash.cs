@@ -0,0 +1,77 @@
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace Embeddinator.Generators
+{
+    /// <summary>
+    /// Builds minimal perfect hash tables with the hash and displace method, so
+    /// generated C code can look names up with two hashes and one comparison.
+    /// </summary>
+    public class PerfectHashTable
+    {
+        // Displacement of each bucket: the seed hashing the names of the bucket
+        // into free slots, or -slot - 1 for buckets holding a single name.
+        public int[] Displacements;
+
+        // Names by slot.
+        public string[] Slots;
+
+        /// <summary>
+        /// Hashes a name with FNV-1a, starting from the seed instead of the offset
+        /// basis when it is not 0. Must match dynamic_hash in c-support.c.
+        /// </summary>
+        public static uint Hash(uint seed, string name)
+        {
+            var hash = seed != 0 ? seed : 0x811c9dc5;
+            foreach (var b in Encoding.UTF8.GetBytes(name))
+                hash = unchecked((hash ^ b) * 0x01000193);
+            return hash;
+        }
+
+        /// <summary>
+        /// Builds a table for the given distinct names.
+        /// </summary>
+        public static PerfectHashTable Build(IList<string> names)
+        {
+            var count = (uint)names.Count;
+            var table = new PerfectHashTable
+            {
+                Displacements = new int[count],
+                Slots = new string[count]
+            };
+
+            var buckets = names.GroupBy(name => Hash(0, name) % count)
+                .OrderByDescending(bucket => bucket.Count())
+                .ToList();
+
+            // Larger buckets are placed first, while most slots are still free.
+            foreach (var bucket in buckets.Where(b => b.Count() > 1))
+            {
+                for (var seed = 1u; ; seed++)
+                {
+                    var slots = bucket.Select(name => Hash(seed, name) % count).ToList();
+                    if (slots.Distinct().Count() != slots.Count || slots.Any(s => table.Slots[s] != null))
+                        continue;
+
+                    table.Displacements[bucket.Key] = (int)seed;
+                    foreach (var entry in bucket.Zip(slots, (name, slot) => new { name, slot }))
+                        table.Slots[entry.slot] = entry.name;
+                    break;
+                }
+            }
+
+            var freeSlot = 0;
+            foreach (var bucket in buckets.Where(b => b.Count() == 1))
+            {
+                while (table.Slots[freeSlot] != null)
+                    freeSlot++;
+
+                table.Displacements[bucket.Key] = -freeSlot - 1;
+                table.Slots[freeSlot] = bucket.First();
+            }
+
+            return table;
+        }
+    }
+}
@@ -0,0 +1,387 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using IKVM.Reflection;
+using Emit = System.Reflection.Emit;
+
+namespace Embeddinator.Generators
+{
+    /// <summary>
+    /// Finds the values of members that always evaluate to the same literal,
+    /// so they can be bound as constants instead of being read at runtime.
+    /// </summary>
+    public class ConstantValueReader
+    {
+        static readonly Dictionary<ushort, Emit.OpCode> OpCodes =
+            typeof(Emit.OpCodes).GetFields(System.Reflection.BindingFlags.Public |
+                System.Reflection.BindingFlags.Static)
+            .Select(field => (Emit.OpCode)field.GetValue(null))
+            .GroupBy(op => unchecked((ushort)op.Value))
+            .ToDictionary(ops => ops.Key, ops => ops.First());
+
+        const int FieldDefTable = 0x04;
+
+        // Literals stored to static readonly fields by the static constructor
+        // of each type, by field metadata token.
+        readonly Dictionary<IKVM.Reflection.Type, Dictionary<int, object>> initializers =
+            new Dictionary<IKVM.Reflection.Type, Dictionary<int, object>>();
+
+        /// <summary>
+        /// Gets the value of a const field or of a static readonly field which is
+        /// only ever initialized with a literal, or null if it has no constant value.
+        /// </summary>
+        public object GetFieldValue(FieldInfo field)
+        {
+            if (field.IsLiteral)
+                return ConvertLiteral(field.GetRawConstantValue(), field.FieldType);
+
+            if (!field.IsStatic || !field.IsInitOnly)
+                return null;
+
+            object value;
+            if (!GetInitializers(field.DeclaringType).TryGetValue(field.MetadataToken, out value))
+                return null;
+
+            return ConvertLiteral(value, field.FieldType);
+        }
+
+        /// <summary>
+        /// Gets the value returned by a static read-only property whose getter only
+        /// returns a literal or a constant field, or null if it has no constant value.
+        /// </summary>
+        public object GetPropertyValue(PropertyInfo property)
+        {
+            var getter = property.GetMethod;
+            if (getter == null || property.SetMethod != null || !getter.IsStatic ||
+                getter.GetParameters().Length != 0 || getter.DeclaringType.IsGenericType)
+                return null;
+
+            var body = getter.GetMethodBody();
+            if (body == null)
+                return null;
+
+            var value = EvaluateGetter(getter.Module, body.GetILAsByteArray());
+            return value == null ? null : ConvertLiteral(value, property.PropertyType);
+        }
+
+        struct Instruction
+        {
+            public Emit.OpCode OpCode;
+            public int Next;
+            public long Operand;
+        }
+
+        static bool Decode(byte[] il, int offset, out Instruction instruction)
+        {
+            instruction = new Instruction();
+
+            if (offset >= il.Length)
+                return false;
+
+            ushort value = il[offset++];
+            if (value == 0xFE)
+            {
+                if (offset >= il.Length)
+                    return false;
+                value = (ushort)(0xFE00 | il[offset++]);
+            }
+
+            if (!OpCodes.TryGetValue(value, out instruction.OpCode))
+                return false;
+
+            int size;
+            switch (instruction.OpCode.OperandType)
+            {
+            case Emit.OperandType.InlineNone:
+                size = 0;
+                break;
+            case Emit.OperandType.ShortInlineBrTarget:
+            case Emit.OperandType.ShortInlineI:
+            case Emit.OperandType.ShortInlineVar:
+                size = 1;
+                break;
+            case Emit.OperandType.InlineVar:
+                size = 2;
+                break;
+            case Emit.OperandType.InlineI8:
+            case Emit.OperandType.InlineR:
+                size = 8;
+                break;
+            case Emit.OperandType.InlineSwitch:
+                if (offset + 4 > il.Length)
+                    return false;
+                size = 4 + 4 * BitConverter.ToInt32(il, offset);
+                break;
+            default:
+                size = 4;
+                break;
+            }
+
+            if (size < 0 || offset + size > il.Length)
+                return false;
+
+            switch (size)
+            {
+            case 1:
+                instruction.Operand = instruction.OpCode.OperandType == Emit.OperandType.ShortInlineVar ?
+                    il[offset] : (sbyte)il[offset];
+                break;
+            case 2:
+                instruction.Operand = BitConverter.ToUInt16(il, offset);
+                break;
+            case 4:
+                instruction.Operand = BitConverter.ToInt32(il, offset);
+                break;
+            case 8:
+                instruction.Operand = BitConverter.ToInt64(il, offset);
+                break;
+            }
+
+            instruction.Next = offset + size;
+            return true;
+        }
+
+        // Gets the literal pushed by a load instruction, if it is one.
+        static bool TryGetLiteral(Module module, Instruction instruction, out object value)
+        {
+            value = null;
+
+            var op = instruction.OpCode;
+            if (op == Emit.OpCodes.Ldc_I4_M1)
+                value = -1;
+            else if (op.Value >= Emit.OpCodes.Ldc_I4_0.Value && op.Value <= Emit.OpCodes.Ldc_I4_8.Value)
+                value = op.Value - Emit.OpCodes.Ldc_I4_0.Value;
+            else if (op == Emit.OpCodes.Ldc_I4_S || op == Emit.OpCodes.Ldc_I4)
+                value = (int)instruction.Operand;
+            else if (op == Emit.OpCodes.Ldc_I8)
+                value = instruction.Operand;
+            else if (op == Emit.OpCodes.Ldc_R4)
+                value = BitConverter.ToSingle(BitConverter.GetBytes((int)instruction.Operand), 0);
+            else if (op == Emit.OpCodes.Ldc_R8)
+                value = BitConverter.Int64BitsToDouble(instruction.Operand);
+            else if (op == Emit.OpCodes.Ldstr)
+                value = module.ResolveString((int)instruction.Operand);
+
+            return value != null;
+        }
+
+        // Applies the conversions the compiler emits after loading 32-bit literals.
+        static bool TryConvert(Instruction instruction, ref object value)
+        {
+            var op = instruction.OpCode;
+            if (op == Emit.OpCodes.Conv_I8 && value is int)
+                value = (long)(int)value;
+            else if (op == Emit.OpCodes.Conv_U8 && value is int)
+                value = (long)(uint)(int)value;
+            else if (op == Emit.OpCodes.Conv_R4 && (value is int || value is long))
+                value = (float)Convert.ToInt64(value);
+            else if (op == Emit.OpCodes.Conv_R8 && (value is int || value is long))
+                value = (double)Convert.ToInt64(value);
+            else
+                return false;
+
+            return true;
+        }
+
+        Dictionary<int, object> GetInitializers(IKVM.Reflection.Type type)
+        {
+            Dictionary<int, object> values;
+            if (initializers.TryGetValue(type, out values))
+                return values;
+
+            values = new Dictionary<int, object>();
+            initializers[type] = values;
+
+            var cctor = type.IsGenericType ? null : type.TypeInitializer;
+            var body = cctor?.GetMethodBody();
+            if (body == null)
+                return values;
+
+            var il = body.GetILAsByteArray();
+            var stored = new HashSet<int>();
+
+            object pending = null;
+            Instruction instruction;
+            for (var offset = 0; offset < il.Length; offset = instruction.Next)
+            {
+                // Only straight-line initializers are considered, since a branch
+                // could make any of the stores conditional.
+                if (!Decode(il, offset, out instruction) ||
+                    instruction.OpCode.FlowControl == Emit.FlowControl.Branch ||
+                    instruction.OpCode.FlowControl == Emit.FlowControl.Cond_Branch)
+                {
+                    values.Clear();
+                    return values;
+                }
+
+                object literal;
+                if (TryGetLiteral(cctor.Module, instruction, out literal))
+                {
+                    pending = literal;
+                    continue;
+                }
+
+                if (pending != null && TryConvert(instruction, ref pending))
+                    continue;
+
+                var op = instruction.OpCode;
+                if (op == Emit.OpCodes.Stsfld || op == Emit.OpCodes.Ldsflda)
+                {
+                    var token = (int)instruction.Operand;
+
+                    // Fields stored more than once or written through their
+                    // address do not have a single value.
+                    if (!stored.Add(token) || op == Emit.OpCodes.Ldsflda || pending == null ||
+                        (token >> 24) != FieldDefTable)
+                        values.Remove(token);
+                    else
+                        values[token] = pending;
+                }
+
+                pending = null;
+            }
+
+            foreach (var token in values.Keys.ToList())
+            {
+                var field = cctor.Module.ResolveField(token);
+                if (!field.DeclaringType.Equals(type) || !field.IsInitOnly)
+                    values.Remove(token);
+            }
+
+            return values;
+        }
+
+        // Evaluates a getter made of a single literal or constant field load,
+        // including the local round-trip emitted by debug builds.
+        object EvaluateGetter(Module module, byte[] il)
+        {
+            object top = null;
+            object local = null;
+
+            Instruction instruction;
+            for (var offset = 0; offset < il.Length; offset = instruction.Next)
+            {
+                if (!Decode(il, offset, out instruction))
+                    return null;
+
+                object literal;
+                if (TryGetLiteral(module, instruction, out literal))
+                {
+                    if (top != null)
+                        return null;
+                    top = literal;
+                    continue;
+                }
+
+                var op = instruction.OpCode;
+                if (op == Emit.OpCodes.Nop)
+                    continue;
+
+                if (op == Emit.OpCodes.Ret)
+                    return top;
+
+                if (top != null && TryConvert(instruction, ref top))
+                    continue;
+
+                if (op == Emit.OpCodes.Ldsfld && top == null)
+                {
+                    // Fields of other modules are not resolved, since consts
+                    // are already inlined by the compiler.
+                    var token = (int)instruction.Operand;
+                    if ((token >> 24) != FieldDefTable)
+                        return null;
+
+                    top = GetFieldValue(module.ResolveField(token));
+                    if (top == null)
+                        return null;
+                }
+                else if (op == Emit.OpCodes.Stloc_0 && top != null)
+                {
+                    local = top;
+                    top = null;
+                }
+                else if (op == Emit.OpCodes.Ldloc_0 && local != null && top == null)
+                {
+                    top = local;
+                }
+                else if ((op == Emit.OpCodes.Br_S || op == Emit.OpCodes.Br) &&
+                         instruction.Operand >= 0)
+                {
+                    instruction.Next += (int)instruction.Operand;
+                }
+                else
+                {
+                    return null;
+                }
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Converts a literal to the representation of the primitive, enum or string
+        /// type it is stored as, or returns null if the type has no constant form.
+        /// </summary>
+        public static object ConvertLiteral(object value, IKVM.Reflection.Type type)
+        {
+            if (value == null)
+                return null;
+
+            if (type.IsEnum)
+                type = type.GetEnumUnderlyingType();
+
+            var typeCode = IKVM.Reflection.Type.GetTypeCode(type);
+
+            if (typeCode == TypeCode.String)
+                return value as string;
+
+            if (value is string)
+                return null;
+
+            if (typeCode == TypeCode.Single || typeCode == TypeCode.Double)
+            {
+                var real = Convert.ToDouble(value);
+                if (double.IsNaN(real) || double.IsInfinity(real))
+                    return null;
+
+                if (typeCode == TypeCode.Single)
+                    return value is float ? value : (float)real;
+                return real;
+            }
+
+            if (value is float || value is double)
+                return null;
+
+            var bits = value is ulong ? unchecked((long)(ulong)value) : Convert.ToInt64(value);
+
+            unchecked
+            {
+                switch (typeCode)
+                {
+                case TypeCode.Boolean:
+                    return bits != 0;
+                case TypeCode.Char:
+                    return (char)bits;
+                case TypeCode.SByte:
+                    return (sbyte)bits;
+                case TypeCode.Byte:
+                    return (byte)bits;
+                case TypeCode.Int16:
+                    return (short)bits;
+                case TypeCode.UInt16:
+                    return (ushort)bits;
+                case TypeCode.Int32:
+                    return (int)bits;
+                case TypeCode.UInt32:
+                    return (uint)bits;
+                case TypeCode.Int64:
+                    return bits;
+                case TypeCode.UInt64:
+                    return (ulong)bits;
+                }
+            }
+
+            return null;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+using System.Collections.Generic;
+using System.Linq;
+using CppSharp.AST;
+using CppSharp.Generators;
+
+namespace Embeddinator.Generators
+{
+    /// <summary>
+    /// Generates header-only C++ wrappers on top of the C bindings, which
+    /// need to be generated first by the C generator.
+    /// </summary>
+    public class CppGenerator : Generator
+    {
+        public CppGenerator(BindingContext context)
+            : base(context)
+        {
+        }
+
+        public override List<CodeGenerator> Generate(IEnumerable<TranslationUnit> units)
+        {
+            var unit = units.First();
+            var headers = new CppHeaders(Context, unit);
+
+            return new List<CodeGenerator> { headers };
+        }
+
+        public override bool SetupPasses()
+        {
+            return true;
+        }
+
+        protected override string TypePrinterDelegate(Type type)
+        {
+            return type.ToString();
+        }
+
+        /// <summary>
+        /// Gets the C++ namespace all the wrappers of an assembly are declared in,
+        /// which keeps them apart from the C declarations of the same types.
+        /// </summary>
+        public static string GetRootNamespace(TranslationUnit unit) =>
+            JavaGenerator.FileNameAsIdentifier(unit.FileName);
+
+        public static string GetNamespace(Declaration decl)
+        {
+            var namespaces = Declaration.GatherNamespaces(decl.Namespace)
+                .Where(ns => !(ns is TranslationUnit) && !(ns is Class))
+                .Select(ns => ns.Name);
+
+            return string.Join("::", new[] { GetRootNamespace(decl.TranslationUnit) }
+                .Concat(namespaces));
+        }
+
+        /// <summary>
+        /// Gets the C++ name of a type. Nested types are declared in the namespace
+        /// of their outermost type, so their names are prefixed with the names of
+        /// their outer types to keep them apart from the other types there.
+        /// </summary>
+        public static string GetName(Declaration decl)
+        {
+            string managedName;
+            if (!ASTGenerator.ManagedNames.TryGetValue(decl, out managedName))
+                return decl.Name;
+
+            var nesting = managedName.Split('+');
+            if (nesting.Length == 1)
+                return decl.Name;
+
+            var outerNames = nesting.Take(nesting.Length - 1)
+                .Select(name => name.Substring(name.LastIndexOf('.') + 1))
+                .Select(name => name.Replace('`', '_'));
+
+            return string.Join("_", outerNames.Concat(new[] { decl.Name }));
+        }
+
+        public static string QualifiedName(Declaration decl) =>
+            $"{GetNamespace(decl)}::{GetName(decl)}";
+
+        /// <summary>
+        /// Gets the name of a declaration in the C bindings.
+        /// </summary>
+        public static string CQualifiedName(Declaration decl)
+        {
+            var isSwiftTarget = CGenerator.Options.GeneratorKinds.Contains(GeneratorKind.Swift);
+            return isSwiftTarget ? $"_{decl.QualifiedName}" : decl.QualifiedName;
+        }
+    }
+}
@@ -0,0 +1,452 @@
+using System.Collections.Generic;
+using System.Linq;
+using CppSharp;
+using CppSharp.AST;
+using CppSharp.AST.Extensions;
+using CppSharp.Generators;
+using Embeddinator.Passes;
+
+namespace Embeddinator.Generators
+{
+    /// <summary>
+    /// Generates a C++ header wrapping the C bindings of a managed assembly
+    /// with move-only classes owning the GC handle of each managed object.
+    /// </summary>
+    public class CppHeaders : CCodeGenerator
+    {
+        public CppHeaders(BindingContext context, TranslationUnit unit)
+            : base(context, unit)
+        {
+        }
+
+        public override string FileExtension => "hpp";
+
+        static CManagedToNativeTypePrinter NativeTypePrinter =>
+            CGenerator.GetCTypePrinter(GeneratorKind.C);
+
+        const string ObjectBase = "mono_embeddinator::object";
+
+        public override void WriteHeaders()
+        {
+            WriteLine("#pragma once");
+            NewLine();
+
+            WriteInclude($"{Unit.FileNameWithoutExtension}.h");
+            WriteInclude("cpp-support.hpp");
+
+            var referencedDecls = new GetReferencedDecls();
+            Unit.Visit(referencedDecls);
+
+            var dependencies = referencedDecls.Declarations
+                .Where(d => !d.IsImplicit && d.TranslationUnit != Unit)
+                .Select(d => d.TranslationUnit).Distinct();
+
+            foreach (var dep in dependencies)
+                WriteInclude($"{dep.FileNameWithoutExtension}.hpp");
+        }
+
+        public override void Process()
+        {
+            GenerateFilePreamble(CommentKind.BCPL, "Embeddinator-4000");
+
+            PushBlock();
+            WriteHeaders();
+            PopBlock(NewLineKind.BeforeNextBlock);
+
+            var declarations = GetDeclarations(Unit).ToList();
+            var enums = declarations.OfType<Enumeration>().ToList();
+            var classes = SortByBaseClass(declarations.OfType<Class>()).ToList();
+
+            foreach (var group in enums.Cast<Declaration>().Concat(classes)
+                .GroupBy(CppGenerator.GetNamespace))
+            {
+                PushBlock();
+                WriteLine($"namespace {group.Key}");
+                WriteStartBraceIndent();
+
+                foreach (var @enum in group.OfType<Enumeration>())
+                    GenerateEnum(@enum);
+
+                foreach (var @class in group.OfType<Class>())
+                    WriteLine($"class {CppGenerator.GetName(@class)};");
+
+                WriteCloseBraceIndent();
+                PopBlock(NewLineKind.BeforeNextBlock);
+            }
+
+            foreach (var @class in classes)
+                GenerateClassDeclaration(@class);
+
+            foreach (var @class in classes)
+                GenerateClassDefinitions(@class);
+        }
+
+        static IEnumerable<Declaration> GetDeclarations(DeclarationContext context)
+        {
+            foreach (var decl in context.Declarations)
+            {
+                if (!decl.IsGenerated || decl.IsImplicit)
+                    continue;
+
+                if (decl is Namespace)
+                {
+                    foreach (var child in GetDeclarations(decl as Namespace))
+                        yield return child;
+                }
+                else if (decl is Class || decl is Enumeration)
+                    yield return decl;
+            }
+        }
+
+        // Base classes need to be complete before the classes deriving from them.
+        static IEnumerable<Class> SortByBaseClass(IEnumerable<Class> classes)
+        {
+            var sorted = new List<Class>();
+            var pending = classes.ToList();
+
+            foreach (var @class in pending)
+                AddWithBaseClasses(@class, pending, sorted);
+
+            return sorted;
+        }
+
+        static void AddWithBaseClasses(Class @class, List<Class> classes, List<Class> sorted)
+        {
+            if (sorted.Contains(@class))
+                return;
+
+            var baseClass = GetBaseClass(@class);
+            if (baseClass != null && classes.Contains(baseClass))
+                AddWithBaseClasses(baseClass, classes, sorted);
+
+            sorted.Add(@class);
+        }
+
+        static Class GetBaseClass(Class @class)
+        {
+            if (!@class.HasBaseClass || !@class.BaseClass.IsGenerated ||
+                @class.BaseClass.IsInterface || @class.BaseClass.IsStatic)
+                return null;
+
+            return @class.BaseClass;
+        }
+
+        void GenerateEnum(Enumeration @enum)
+        {
+            var underlyingType = NativeTypePrinter.VisitPrimitiveType(@enum.BuiltinType.Type);
+            var enumName = CppGenerator.GetName(@enum);
+
+            WriteLine($"enum class {enumName} : {underlyingType}");
+            WriteStartBraceIndent();
+
+            foreach (var item in @enum.Items)
+                WriteLine($"{item.Name} = {@enum.GetItemValueAsString(item)},");
+
+            PopIndent();
+            WriteLine("};");
+
+            if (@enum.Modifiers.HasFlag(Enumeration.EnumModifiers.Flags))
+            {
+                foreach (var op in new[] { "|", "&", "^" })
+                {
+                    NewLine();
+                    WriteLine($"inline constexpr {enumName} operator{op}({enumName} a, {enumName} b) noexcept");
+                    WriteStartBraceIndent();
+                    WriteLine($"return static_cast<{enumName}>(static_cast<{underlyingType}>(a) " +
+                        $"{op} static_cast<{underlyingType}>(b));");
+                    WriteCloseBraceIndent();
+                }
+            }
+
+            NewLine();
+        }
+
+        #region Type mapping
+
+        static bool IsSpanElementType(Type type)
+        {
+            PrimitiveType primitive;
+            return type.IsPrimitiveType(out primitive) && primitive != PrimitiveType.String &&
+                primitive != PrimitiveType.Decimal && primitive != PrimitiveType.Void;
+        }
+
+        static bool IsWrappedClass(Class @class) =>
+            @class.IsGenerated && !@class.IsImplicit && !@class.IsStatic;
+
+        /// <summary>
+        /// Gets the C++ type of a parameter or return type, or null if it
+        /// cannot be wrapped.
+        /// </summary>
+        static string GetCppType(Type type, bool isReturn)
+        {
+            PrimitiveType primitive;
+            if (type.IsPrimitiveType(out primitive))
+            {
+                switch (primitive)
+                {
+                case PrimitiveType.Void:
+                    return isReturn ? "void" : null;
+                case PrimitiveType.Null:
+                    return null;
+                case PrimitiveType.String:
+                    return isReturn ? "mono_embeddinator::owned_string" : "mono_embeddinator::string_ref";
+                default:
+                    return NativeTypePrinter.VisitPrimitiveType(primitive);
+                }
+            }
+
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return @enum.IsGenerated ? CppGenerator.QualifiedName(@enum) : null;
+
+            Class @class;
+            if (type.TryGetClass(out @class))
+            {
+                if (!IsWrappedClass(@class))
+                    return null;
+
+                var name = CppGenerator.QualifiedName(@class);
+                return isReturn ? name : $"const {name}&";
+            }
+
+            var array = type as ManagedArrayType;
+            if (array != null && IsSpanElementType(array.Array.Type))
+            {
+                var elementType = NativeTypePrinter.VisitPrimitiveType(GetPrimitive(array.Array.Type));
+                return isReturn ? $"mono_embeddinator::array<{elementType}>" :
+                    $"mono_embeddinator::span<const {elementType}>";
+            }
+
+            return null;
+        }
+
+        static PrimitiveType GetPrimitive(Type type)
+        {
+            PrimitiveType primitive;
+            type.IsPrimitiveType(out primitive);
+            return primitive;
+        }
+
+        static string MarshalArgument(Type type, string name)
+        {
+            if (type.IsPrimitiveType(PrimitiveType.String))
+                return $"{name}.c_str()";
+
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return $"static_cast<{CppGenerator.CQualifiedName(@enum)}>({name})";
+
+            if (type.IsClass())
+                return $"mono_embeddinator::get_handle({name})";
+
+            var array = type as ManagedArrayType;
+            if (array != null)
+            {
+                var elementType = NativeTypePrinter.VisitPrimitiveType(GetPrimitive(array.Array.Type));
+                return $"mono_embeddinator::array_arg<{elementType}>({name})";
+            }
+
+            return name;
+        }
+
+        static string MarshalReturn(Type type, string call)
+        {
+            if (type.IsPrimitiveType(PrimitiveType.String) || type.IsClass() || type is ManagedArrayType)
+            {
+                var cppType = GetCppType(type, isReturn: true);
+                var tag = type.IsClass() ? "mono_embeddinator::adopt, " : string.Empty;
+                return $"{cppType}({tag}{call})";
+            }
+
+            Enumeration @enum;
+            if (type.TryGetEnum(out @enum))
+                return $"static_cast<{GetCppType(type, isReturn: true)}>({call})";
+
+            return call;
+        }
+
+        #endregion
+
+        #region Members
+
+        class Member
+        {
+            public Method Method;
+            public string NativeName;
+            public bool IsNoExcept;
+        }
+
+        static IEnumerable<Member> GetMembers(Class @class)
+        {
+            var methods = @class.Methods.Where(m => m.AssociatedDeclaration == null)
+                .Select(m => new Member { Method = m });
+
+            var accessors = @class.Properties.Where(p => p.IsGenerated)
+                .SelectMany(p => new[] { p.GetMethod, p.SetMethod }
+                    .Where(m => m != null)
+                    // Field accessors don't run managed code, so they can't throw.
+                    .Select(m => new Member { Method = m, IsNoExcept = p.Field != null }));
+
+            foreach (var member in methods.Concat(accessors))
+            {
+                if (!IsWrappedMethod(member.Method, @class))
+                    continue;
+
+                if (!CCodeGenerator.GeneratedMethodNames.TryGetValue(
+                    member.Method.ManagedQualifiedName(), out member.NativeName))
+                    continue;
+
+                yield return member;
+            }
+        }
+
+        static bool IsWrappedMethod(Method method, Class @class)
+        {
+            if (!method.IsGenerated || method.IsImplicit || method.IsDestructor ||
+                method.Access != AccessSpecifier.Public)
+                return false;
+
+            if (method.IsConstructor && (@class.IsAbstract || @class.IsStatic || @class.IsInterface))
+                return false;
+
+            var @params = method.Parameters.Where(p => !p.IsImplicit).ToList();
+            if (@params.Any(p => p.Usage != ParameterUsage.In || GetCppType(p.Type, isReturn: false) == null))
+                return false;
+
+            // A constructor taking the class itself would clash with the deleted copy constructor.
+            Class paramClass;
+            if (method.IsConstructor && @params.Count == 1 &&
+                @params[0].Type.TryGetClass(out paramClass) && paramClass == @class)
+                return false;
+
+            return method.IsConstructor || GetCppType(method.ReturnType.Type, isReturn: true) != null;
+        }
+
+        string GetParameters(Method method)
+        {
+            return string.Join(", ", method.Parameters.Where(p => !p.IsImplicit)
+                .Select(p => $"{GetCppType(p.Type, isReturn: false)} {p.Name}"));
+        }
+
+        string GetArguments(Method method)
+        {
+            var args = method.Parameters.Where(p => !p.IsImplicit)
+                .Select(p => MarshalArgument(p.Type, p.Name));
+
+            if (!method.IsStatic && !method.IsConstructor)
+                args = new[] { "_handle" }.Concat(args);
+
+            return string.Join(", ", args);
+        }
+
+        #endregion
+
+        void GenerateClassDeclaration(Class @class)
+        {
+            PushBlock();
+
+            WriteLine($"namespace {CppGenerator.GetNamespace(@class)}");
+            WriteStartBraceIndent();
+
+            var className = CppGenerator.GetName(@class);
+            var baseClass = GetBaseClass(@class);
+            var baseName = baseClass != null ? CppGenerator.QualifiedName(baseClass) : ObjectBase;
+
+            if (@class.IsStatic)
+                WriteLine($"class {className} final");
+            else
+                WriteLine($"class {className} : public {baseName}");
+            WriteStartBraceIndent();
+
+            PopIndent();
+            WriteLine("public:");
+            PushIndent();
+
+            if (@class.IsStatic)
+            {
+                WriteLine($"{className}() = delete;");
+            }
+            else
+            {
+                WriteLine($"{className}(std::nullptr_t) noexcept");
+                WriteLineIndent($": {baseName}(nullptr) {{}}");
+                WriteLine($"{className}(mono_embeddinator::adopt_t tag, void* handle) noexcept");
+                WriteLineIndent($": {baseName}(tag, handle) {{}}");
+                WriteLine($"{className}({className}&&) noexcept = default;");
+                WriteLine($"{className}& operator=({className}&&) noexcept = default;");
+            }
+
+            var members = GetMembers(@class).ToList();
+            if (members.Count > 0)
+                NewLine();
+
+            foreach (var member in members)
+            {
+                var method = member.Method;
+                var @params = GetParameters(method);
+
+                if (method.IsConstructor)
+                {
+                    var @explicit = method.Parameters.Count(p => !p.IsImplicit) == 1 ? "explicit " : string.Empty;
+                    WriteLine($"{@explicit}{className}({@params});");
+                    continue;
+                }
+
+                var @static = method.IsStatic ? "static " : string.Empty;
+                var @const = method.IsStatic ? string.Empty : " const";
+                var noexcept = member.IsNoExcept ? " noexcept" : string.Empty;
+                var retType = GetCppType(method.ReturnType.Type, isReturn: true);
+
+                WriteLine($"{@static}{retType} {method.Name}({@params}){@const}{noexcept};");
+            }
+
+            PopIndent();
+            WriteLine("};");
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
+        void GenerateClassDefinitions(Class @class)
+        {
+            var className = CppGenerator.QualifiedName(@class);
+            var baseClass = GetBaseClass(@class);
+            var baseName = baseClass != null ? CppGenerator.QualifiedName(baseClass) : ObjectBase;
+
+            foreach (var member in GetMembers(@class))
+            {
+                var method = member.Method;
+                var @params = GetParameters(method);
+                var call = $"::{member.NativeName}({GetArguments(method)})";
+
+                PushBlock();
+
+                if (method.IsConstructor)
+                {
+                    WriteLine($"inline {className}::{CppGenerator.GetName(@class)}({@params})");
+                    WriteLineIndent($": {baseName}(mono_embeddinator::adopt, {call})");
+                    WriteStartBraceIndent();
+                    WriteCloseBraceIndent();
+                    PopBlock(NewLineKind.BeforeNextBlock);
+                    continue;
+                }
+
+                var @const = method.IsStatic ? string.Empty : " const";
+                var noexcept = member.IsNoExcept ? " noexcept" : string.Empty;
+                var retType = method.ReturnType.Type;
+
+                WriteLine($"inline {GetCppType(retType, isReturn: true)} {className}::{method.Name}" +
+                    $"({@params}){@const}{noexcept}");
+                WriteStartBraceIndent();
+
+                if (retType.IsPrimitiveType(PrimitiveType.Void))
+                    WriteLine($"{call};");
+                else
+                    WriteLine($"return {MarshalReturn(retType, call)};");
+
+                WriteCloseBraceIndent();
+                PopBlock(NewLineKind.BeforeNextBlock);
+            }
+        }
+    }
+}
@@ -25,7 +25,14 @@ namespace Embeddinator.Generators
         public override bool VisitManagedArrayType(ManagedArrayType array,
             TypeQualifiers quals)
         {
-            Return.Write("null");
+            if (IsByRefParameter || !IsBlittableArrayElement(array.Array.Type))
+            {
+                Return.Write("null");
+                return true;
+            }
+
+            var elementSize = JavaTypePrinter.GetBufferElementSize(array.Array.Type);
+            Return.Write($"mono.embeddinator.NativeArray.describe({ArgName}, {elementSize})");
             return true;
         }
 
@@ -73,40 +80,17 @@ namespace Embeddinator.Generators
             Before.WriteLineIndent($"throw new NullRefParameterException(\"{Parameter.Name}\");");
         }
 
-        static bool IsReferenceIntegerType(PrimitiveType type)
-        {
-            switch(type)
-            {
-            case PrimitiveType.UChar:
-            case PrimitiveType.UShort:
-            case PrimitiveType.UInt:
-            case PrimitiveType.ULong:
-            case PrimitiveType.ULongLong:
-                return true;
-            }
-            return false;
-        }
-
-        static PrimitiveType GetSignedIntegerType(PrimitiveType type)
+        public void HandleRefOutPrimitiveType(PrimitiveType type, Enumeration @enum = null)
         {
-            switch(type)
+            // Primitive holders keep their value in native memory, so they are
+            // passed to native code as is.
+            if (@enum == null && JavaTypePrinter.GetHolderKind(type) != null)
             {
-            case PrimitiveType.UChar:
-                return PrimitiveType.SChar;
-            case PrimitiveType.UShort:
-                return PrimitiveType.Short;
-            case PrimitiveType.UInt:
-                return PrimitiveType.Int;
-            case PrimitiveType.ULong:
-                return PrimitiveType.Long;
-            case PrimitiveType.ULongLong:
-                return PrimitiveType.LongLong;
+                CheckRefOutParameter(nullCheck: false);
+                Return.Write(ArgName);
+                return;
             }
-            throw new System.NotImplementedException();
-        }
 
-        public void HandleRefOutPrimitiveType(PrimitiveType type, Enumeration @enum = null)
-        {
             TypePrinter.PushContext(TypePrinterContextKind.Native);
             var typeName = Parameter.Visit(TypePrinter);
             TypePrinter.PopContext();
@@ -119,20 +103,11 @@ namespace Embeddinator.Generators
             if (isEnum)
                 marshal = $"{marshal}.getValue()";
 
-            if (type == PrimitiveType.Bool)
-                marshal = $"((byte) ({marshal} ? 1 : 0))";
-
-            if (IsReferenceIntegerType(type))
-            {
-                var integerTypeName = TypePrinter.VisitPrimitiveType(GetSignedIntegerType(type));
-                marshal = $"({integerTypeName}){marshal}.intValue()";
-            }
-
             var varName = JavaGenerator.GeneratedIdentifier(ArgName);
 
             Before.Write($"{typeName} {varName} = ");
 
-            if (isEnum || type == PrimitiveType.Bool || IsReferenceIntegerType(type))
+            if (isEnum)
                 Before.WriteLine($"new {typeName}({marshal});");
             else
                 Before.WriteLine($"({marshal}) != null ? new {typeName}({marshal}) : new {typeName}();");
@@ -145,16 +120,6 @@ namespace Embeddinator.Generators
             if (isEnum)
                 marshal = $"{@enum.Visit(TypePrinter)}.fromOrdinal({value})";
 
-            if (type == PrimitiveType.Bool)
-                marshal = $"{value} != 0";
-
-            if (IsReferenceIntegerType(type))
-            {
-                var unrefType = Parameter.Type.GetPointee();
-                var integerTypeName = unrefType.Visit(TypePrinter);
-                marshal = $"new {integerTypeName}({value})";
-            }
-
             After.WriteLine($"{ArgName}.set({marshal});");
         }
 
@@ -215,7 +180,14 @@ namespace Embeddinator.Generators
         public override bool VisitManagedArrayType(ManagedArrayType array,
             TypeQualifiers quals)
         {
-            Return.Write("null");
+            if (!IsBlittableArrayElement(array.Array.Type))
+            {
+                Return.Write("null");
+                return true;
+            }
+
+            var kind = JavaTypePrinter.GetBufferKind(array.Array.Type);
+            Return.Write($"mono.embeddinator.NativeArray.as{kind}Buffer({ReturnVarName})");
             return true;
         }
 
@@ -245,6 +217,8 @@ namespace Embeddinator.Generators
                 Return.Write($"{ReturnVarName} != 0");
             else if (type == PrimitiveType.Decimal)
                 Return.Write($"{ReturnVarName}.getValue()");
+            else if (type == PrimitiveType.String)
+                Return.Write($"mono.embeddinator.Runtime.takeString({ReturnVarName})");
             else
                 Return.Write(ReturnVarName);
             return true;
@@ -84,9 +84,10 @@ namespace Embeddinator.Generators
 
             PushBlock(BlockKind.Method, method);
 
+            var returnTypeName = TypePrinter.VisitNativeReturnType(method.ReturnType);
+
             TypePrinter.PushContext(TypePrinterContextKind.Native);
 
-            var returnTypeName = method.ReturnType.Visit(TypePrinter);
             Write($"public {returnTypeName} {GetCMethodIdentifier(method)}(");
             Write(TypePrinter.VisitParameters(method.Parameters, hasNames: true).ToString());
             Write(");");
@@ -1,8 +1,10 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Globalization;
 using System.IO;
 using System.Linq;
+using System.Text;
 using CppSharp;
 using CppSharp.AST;
 using CppSharp.AST.Extensions;
@@ -127,9 +129,8 @@ namespace Embeddinator.Generators
             WriteLine($"public {typeName} getValue() {{ return id; }}");
 
             NewLine();
-            var value = @enum.BuiltinType.IsUnsigned ? "n.intValue()" : "n";
             WriteLine($"public static {@enum.Name} fromOrdinal({typeName} n) {{");
-            WriteLineIndent($"return valuesMap.containsKey({value}) ? valuesMap.get({value}) : new {@enum.Name}(n);");
+            WriteLineIndent($"return valuesMap.containsKey(n) ? valuesMap.get(n) : new {@enum.Name}(n);");
             WriteLine("}");
 
             TypePrinter.PushContext(TypePrinterContextKind.Template);
@@ -191,14 +192,15 @@ namespace Embeddinator.Generators
             {
                 var value = @enum.GetItemValueAsString(item);
 
+                // Unsigned 64-bit values above the range of long keep their bits.
+                if (@enum.BuiltinType.IsUnsigned && item.Value > Int64.MaxValue)
+                    value = unchecked((long)item.Value).ToString();
+
                 // We need to explicit check for long int literals.
                 if (item.Value > Int32.MaxValue)
                     value += "L";
 
-                if (@enum.BuiltinType.IsUnsigned)
-                    Write($"(new {typeName}({value}));");
-                else
-                    Write($"(({typeName}){value});");
+                Write($"(({typeName}){value});");
             }
 
             return true;
@@ -276,12 +278,106 @@ namespace Embeddinator.Generators
                 }
             }
 
+            if (!@class.IsInterface)
+                GenerateConstants(@class);
+
             VisitDeclContext(@class);
             WriteCloseBraceIndent();
 
             return true;
         }
 
+        /// <summary>
+        /// Declares the properties which always evaluate to the same literal as
+        /// constants, which are also returned by their getters.
+        /// </summary>
+        void GenerateConstants(Class @class)
+        {
+            var constants = @class.Properties.Where(p => p.IsGenerated && p.GetMethod != null &&
+                p.GetMethod.IsGenerated && CCodeGenerator.GetConstantProperty(p.GetMethod) != null).ToList();
+
+            foreach (var property in constants)
+            {
+                var keywords = new[] { AccessIdentifier(property.GetMethod.Access), "static", "final" }
+                    .Where(s => !string.IsNullOrWhiteSpace(s));
+                var typeName = property.QualifiedType.Visit(TypePrinter);
+                WriteLine($"{string.Join(" ", keywords)} {typeName} {property.Name} = {GetConstantLiteral(property)};");
+            }
+
+            if (constants.Count > 0)
+                NewLine();
+        }
+
+        string GetConstantLiteral(Property property)
+        {
+            object value;
+            CCodeGenerator.TryGetConstantValue(property, out value);
+
+            var literal = GetLiteral(value);
+
+            Enumeration @enum;
+            if (property.Type.TryGetEnum(out @enum))
+                return $"{property.QualifiedType.Visit(TypePrinter)}.fromOrdinal({literal})";
+
+            return literal;
+        }
+
+        // Unsigned values keep their bits, since they are bound as signed types.
+        static string GetLiteral(object value)
+        {
+            if (value is string)
+                return GetStringLiteral((string)value);
+
+            if (value is bool)
+                return (bool)value ? "true" : "false";
+
+            if (value is char)
+                return $"((char){(int)(char)value})";
+
+            if (value is float || value is double)
+            {
+                var literal = value is float ? ((float)value).ToString("R", CultureInfo.InvariantCulture) :
+                    ((double)value).ToString("R", CultureInfo.InvariantCulture);
+                if (literal.IndexOfAny(new[] { '.', 'E' }) < 0)
+                    literal += ".0";
+                return value is float ? $"{literal}f" : literal;
+            }
+
+            unchecked
+            {
+                if (value is sbyte || value is byte)
+                    return $"((byte){((sbyte)Convert.ToInt64(value)).ToString(CultureInfo.InvariantCulture)})";
+
+                if (value is short || value is ushort)
+                    return $"((short){((short)Convert.ToInt64(value)).ToString(CultureInfo.InvariantCulture)})";
+
+                if (value is int || value is uint)
+                    return ((int)Convert.ToInt64(value)).ToString(CultureInfo.InvariantCulture);
+
+                var bits = value is ulong ? (long)(ulong)value : (long)value;
+                return $"{bits.ToString(CultureInfo.InvariantCulture)}L";
+            }
+        }
+
+        static string GetStringLiteral(string value)
+        {
+            var literal = new StringBuilder("\"");
+            foreach (var c in value)
+            {
+                if (c == '"' || c == '\\')
+                    literal.Append('\\').Append(c);
+                else if (c >= 0x20 && c < 0x7F)
+                    literal.Append(c);
+                else if (c < 0x20)
+                    // Unicode escapes of line terminators would end the literal.
+                    literal.Append('\\').Append(Convert.ToString((int)c, 8).PadLeft(3, '0'));
+                else
+                    literal.Append($"\\u{(int)c:x4}");
+            }
+
+            return literal.Append('"').ToString();
+        }
+
         public static string GetMethodIdentifier(Method method)
         {
             var name = method.Name;
@@ -363,16 +459,78 @@ namespace Embeddinator.Generators
                 if (method.IsConstructor && hasNonInterfaceBase)
                     WriteLine("super((com.sun.jna.Pointer)null);");
 
-                GenerateMethodInvocation(method);
+                var constant = CCodeGenerator.GetConstantProperty(method);
+                if (constant != null && !@class.IsInterface)
+                    WriteLine($"return {constant.Name};");
+                else
+                    GenerateMethodInvocation(method);
 
                 WriteCloseBraceIndent();
             }
 
             PopBlock(NewLineKind.BeforeNextBlock);
 
+            if (!@class.IsInterface && method.Parameters.Any(IsArrayBufferParameter))
+                GenerateArrayOverload(method, @class);
+
             return true;
         }
 
+        static bool IsArrayBufferParameter(Parameter param)
+        {
+            var array = param.Type as ManagedArrayType;
+            return !param.IsImplicit && !param.IsOut && !param.IsInOut && array != null &&
+                CMarshaler.IsBlittableArrayElement(array.Array.Type);
+        }
+
+        /// <summary>
+        /// Generates an overload taking Java arrays in place of the NIO buffers
+        /// primitive arrays are bound as, copying each one to a direct buffer in bulk.
+        /// </summary>
+        void GenerateArrayOverload(Method method, Class @class)
+        {
+            PushBlock(BlockKind.Method, method);
+
+            var keywords = new List<string> { AccessIdentifier(method.Access) };
+            if (method.IsStatic)
+                keywords.Add("static");
+
+            keywords = keywords.Where(s => !string.IsNullOrWhiteSpace(s)).ToList();
+            if (keywords.Count != 0)
+                Write("{0} ", string.Join(" ", keywords));
+
+            var name = method.IsConstructor ? @class.Name : GetMethodIdentifier(method);
+            if (method.IsConstructor)
+                Write("{0}(", name);
+            else
+                Write("{0} {1}(", method.ReturnType, name);
+
+            var @params = method.Parameters.Where(m => !m.IsImplicit).ToList();
+            TypePrinter.UseArrayBuffers = false;
+            Write("{0}", TypePrinter.VisitParameters(@params, hasNames: true));
+            TypePrinter.UseArrayBuffers = true;
+
+            Write(") ");
+            WriteStartBraceIndent();
+
+            var args = @params.Select(param => IsArrayBufferParameter(param) ?
+                $"mono.embeddinator.NativeArray.toBuffer({param.Name})" : param.Name);
+
+            PrimitiveType primitive;
+            method.ReturnType.Type.IsPrimitiveType(out primitive);
+
+            if (method.IsConstructor)
+                Write("this(");
+            else
+                Write("{0}{1}(", primitive != PrimitiveType.Void ? "return " : string.Empty, name);
+
+            Write(string.Join(", ", args));
+            WriteLine(");");
+
+            WriteCloseBraceIndent();
+            PopBlock(NewLineKind.BeforeNextBlock);
+        }
+
         public void GenerateMethodInvocation(Method method)
         {
             var marshalers = new List<Marshaler>();
@@ -406,9 +564,7 @@ namespace Embeddinator.Generators
             var hasReturn = primitive != PrimitiveType.Void && !(method.IsConstructor || method.IsDestructor);
             if (hasReturn)
             {
-                TypePrinter.PushContext(TypePrinterContextKind.Native);
-                var typeName = method.ReturnType.Visit(TypePrinter);
-                TypePrinter.PopContext();
+                var typeName = TypePrinter.VisitNativeReturnType(method.ReturnType);
                 Write($"{typeName.Type} __ret = ");
             }
 
@@ -425,7 +581,9 @@ namespace Embeddinator.Generators
             Write(string.Join(", ", @params));
             WriteLine(");");
 
-            WriteLine("mono.embeddinator.Runtime.checkExceptions();");
+            // Native functions of methods marked with [Embeddinator.NoThrow] never report exceptions.
+            if (!effectiveMethod.HasHint(MarshalHints.NoThrow))
+                WriteLine("mono.embeddinator.Runtime.checkExceptions();");
 
             foreach (var marshal in marshalers)
             {
@@ -12,9 +12,16 @@ namespace Embeddinator.Generators
 
         bool IsByRefParameter => (Parameter != null) && (Parameter.IsOut || Parameter.IsInOut);
 
+        /// <summary>
+        /// If true, arrays of primitive types are printed as direct NIO buffers,
+        /// otherwise as the equivalent Java arrays.
+        /// </summary>
+        public bool UseArrayBuffers { get; set; }
+
         public JavaTypePrinter(BindingContext context)
         {
             Context = context;
+            UseArrayBuffers = true;
         }
 
         public override TypePrinterResult VisitArrayType(ArrayType array,
@@ -23,9 +30,77 @@ namespace Embeddinator.Generators
             if (ContextKind == TypePrinterContextKind.Native)
                 return JavaGenerator.IntPtrType;
 
+            if (!IsByRefParameter && CMarshaler.IsBlittableArrayElement(array.Type))
+            {
+                return UseArrayBuffers ? $"java.nio.{GetBufferKind(array.Type)}Buffer" :
+                    $"{GetBufferKind(array.Type).ToLowerInvariant()}[]";
+            }
+
             return string.Format("{0}[]", array.Type.Visit(this));
         }
 
+        /// <summary>
+        /// Gets the kind of NIO buffer primitive arrays are bound as. Java has no
+        /// unsigned types, so unsigned elements use the signed buffer of the same size.
+        /// </summary>
+        public static string GetBufferKind(CppSharp.AST.Type elementType)
+        {
+            PrimitiveType primitive;
+            elementType.IsPrimitiveType(out primitive);
+
+            switch (primitive)
+            {
+                case PrimitiveType.SChar:
+                case PrimitiveType.UChar:
+                    return "Byte";
+                case PrimitiveType.Short:
+                case PrimitiveType.UShort:
+                    return "Short";
+                case PrimitiveType.Int:
+                case PrimitiveType.UInt:
+                    return "Int";
+                case PrimitiveType.Long:
+                case PrimitiveType.ULong:
+                case PrimitiveType.LongLong:
+                case PrimitiveType.ULongLong:
+                    return "Long";
+                case PrimitiveType.Float:
+                    return "Float";
+                case PrimitiveType.Double:
+                    return "Double";
+            }
+
+            throw new NotSupportedException();
+        }
+
+        public static int GetBufferElementSize(CppSharp.AST.Type elementType)
+        {
+            switch (GetBufferKind(elementType))
+            {
+                case "Byte": return 1;
+                case "Short": return 2;
+                case "Int":
+                case "Float": return 4;
+                default: return 8;
+            }
+        }
+
+        /// <summary>
+        /// Prints the type returned by a native method. Strings are returned as
+        /// a pointer, so they can be released once decoded.
+        /// </summary>
+        public TypePrinterResult VisitNativeReturnType(QualifiedType returnType)
+        {
+            if (returnType.Type.IsPrimitiveType(PrimitiveType.String))
+                return JavaGenerator.IntPtrType;
+
+            PushContext(TypePrinterContextKind.Native);
+            var typeName = returnType.Visit(this);
+            PopContext();
+
+            return typeName;
+        }
+
         static string GetName(Declaration decl)
         {
             var names = new List<string>();
@@ -41,10 +116,59 @@ namespace Embeddinator.Generators
             return GetName(decl);
         }
 
+        /// <summary>
+        /// Gets the kind of the reusable holders ref and out parameters of a
+        /// primitive type are bound as, or null if they use a generic holder.
+        /// </summary>
+        public static string GetHolderKind(PrimitiveType primitive)
+        {
+            switch (primitive)
+            {
+                case PrimitiveType.Bool:
+                    return "Bool";
+                case PrimitiveType.SChar:
+                case PrimitiveType.UChar:
+                    return "Byte";
+                case PrimitiveType.Short:
+                case PrimitiveType.UShort:
+                    return "Short";
+                case PrimitiveType.Int:
+                case PrimitiveType.UInt:
+                    return "Int";
+                case PrimitiveType.Long:
+                case PrimitiveType.ULong:
+                    return "Long";
+                case PrimitiveType.Float:
+                    return "Float";
+                case PrimitiveType.Double:
+                    return "Double";
+            }
+
+            return null;
+        }
+
+        public static string GetHolderTypeName(Parameter param)
+        {
+            PrimitiveType primitive;
+            var pointee = param.Type.GetPointee() ?? param.Type;
+            if (!pointee.IsPrimitiveType(out primitive))
+                return null;
+
+            var kind = GetHolderKind(primitive);
+            if (kind == null)
+                return null;
+
+            return $"mono.embeddinator.{kind}{(param.IsInOut ? "Ref" : "Out")}";
+        }
+
         public override TypePrinterResult VisitParameter(Parameter param, bool hasName)
         {
             if ((param.IsInOut || param.IsOut) && ContextKind != TypePrinterContextKind.Native)
             {
+                var holder = GetHolderTypeName(param);
+                if (holder != null)
+                    return hasName ? $"{holder} {param.Name}" : holder;
+
                 PushContext(TypePrinterContextKind.Template);
                 var paramType = base.VisitParameter(param, false);
                 PushContext(TypePrinterContextKind.Template);
@@ -153,14 +277,16 @@ namespace Embeddinator.Generators
                 case PrimitiveType.Char32:
                 case PrimitiveType.WideChar: return "com.sun.jna.WString";
                 case PrimitiveType.Char: return "char";
-                case PrimitiveType.SChar: return useReferencePrimitiveTypes ? "Byte" : "byte";
-                case PrimitiveType.UChar: return "UnsignedByte";
-                case PrimitiveType.Short: return useReferencePrimitiveTypes ? "Short" : "short";
-                case PrimitiveType.UShort: return "UnsignedShort";
-                case PrimitiveType.Int: return useReferencePrimitiveTypes ? "Integer" : "int";
-                case PrimitiveType.UInt: return "UnsignedInt";
-                case PrimitiveType.Long: return useReferencePrimitiveTypes ? "Long" : "long";
-                case PrimitiveType.ULong: return "UnsignedLong";
+                // Java has no unsigned types, so unsigned values are carried in the
+                // signed type of the same size, keeping their bits.
+                case PrimitiveType.SChar:
+                case PrimitiveType.UChar: return useReferencePrimitiveTypes ? "Byte" : "byte";
+                case PrimitiveType.Short:
+                case PrimitiveType.UShort: return useReferencePrimitiveTypes ? "Short" : "short";
+                case PrimitiveType.Int:
+                case PrimitiveType.UInt: return useReferencePrimitiveTypes ? "Integer" : "int";
+                case PrimitiveType.Long:
+                case PrimitiveType.ULong: return useReferencePrimitiveTypes ? "Long" : "long";
                 case PrimitiveType.LongLong: return "LongLong";
                 case PrimitiveType.ULongLong: return "UnsignedLongLong";
                 case PrimitiveType.Float: return useReferencePrimitiveTypes ? "Float" : "float";
@@ -1,4 +1,5 @@
 using CppSharp.AST;
+using CppSharp.AST.Extensions;
 
 namespace Embeddinator.Generators
 {
@@ -13,4 +14,50 @@ namespace Embeddinator.Generators
             Original = new QualifiedType(typedef);
         }
     }
+
+    /// <summary>
+    /// Represents a managed IEnumerable{T}, IList{T} or IReadOnlyList{T},
+    /// which is exposed to native code as a chunked iterator.
+    /// </summary>
+    public class ManagedEnumerableType : DecayedType
+    {
+        public QualifiedType ElementType { get { return Decayed; } }
+
+        public ManagedEnumerableType(QualifiedType elementType)
+        {
+            Decayed = elementType;
+            Original = elementType;
+        }
+    }
+
+    /// <summary>
+    /// Represents a managed System.IO.Stream, which is exposed to native code
+    /// as a stream handle.
+    /// </summary>
+    public class ManagedStreamType : DecayedType
+    {
+        public ManagedStreamType()
+        {
+            var pointer = new PointerType(new QualifiedType(new BuiltinType(PrimitiveType.Void)));
+            Decayed = new QualifiedType(pointer);
+            Original = new QualifiedType(pointer);
+        }
+    }
+
+    /// <summary>
+    /// Represents a managed Task or Task{T}, which is exposed to native code
+    /// as a future. The result type is void for a Task.
+    /// </summary>
+    public class ManagedTaskType : DecayedType
+    {
+        public QualifiedType ResultType { get { return Decayed; } }
+
+        public bool HasResult => !ResultType.Type.IsPrimitiveType(PrimitiveType.Void);
+
+        public ManagedTaskType(QualifiedType resultType)
+        {
+            Decayed = resultType;
+            Original = resultType;
+        }
+    }
 }
\ No newline at end of file
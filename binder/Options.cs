@@ -4,6 +4,18 @@ using CppSharp.Generators;
 
 namespace Embeddinator
 {
+    /// <summary>
+    /// Represents how the bound assemblies are ahead-of-time compiled.
+    /// </summary>
+    public enum AotMode
+    {
+        None,
+        // The AOT images are used when possible, falling back to the JIT.
+        Normal,
+        // All the code is precompiled and the JIT is disabled at runtime.
+        Full
+    }
+
     public class Options : DriverOptions
     {
         /// <summary>
@@ -23,5 +35,73 @@ namespace Embeddinator
 
         // If true, will generate support files alongside generated binding code.
         public bool GenerateSupportFiles = true;
+
+        // If true, will generate a snapshot function and struct for each class,
+        // reading all its public readable properties in a single call.
+        public bool GenerateSnapshots;
+
+        // The maximum number of translation units generated in parallel.
+        // Defaults to the number of processors when zero or less.
+        public int GenerationJobs;
+
+        // If true, generation is skipped when the input assemblies and options
+        // match the ones recorded in the output directory by a previous run.
+        public bool Incremental;
+
+        // If true, native code is compiled with optimizations and link-time
+        // optimization, unused functions are removed and only the bound
+        // entry points are exported.
+        public bool ReleaseMode;
+
+        // Directory where instrumented release builds write the profile data
+        // collected by a training run, for profile-guided optimization.
+        public string ProfileGenerateDir;
+
+        // Directory of the profile data used to optimize release builds.
+        public string ProfileUseDir;
+
+        // How the bound assemblies and their dependencies are ahead-of-time
+        // compiled on desktop platforms when compiling the generated code.
+        public AotMode AotMode;
+
+        // If true, the bound assemblies and their AOT images are embedded in the
+        // native library instead of being loaded from disk.
+        public bool Bundle;
+
+        // If true, the native library does not link to the Mono runtime, which
+        // is loaded on the first call into the bindings instead.
+        public bool LazyRuntime;
+
+        // If true, a report of the estimated marshaling cost of each binding
+        // is written next to the generated code.
+        public bool GenerateCostReport;
+
+        // Estimated cost at which a binding is warned about in the cost report.
+        public int CostReportThreshold = Passes.MarshalingCostPass.DefaultThreshold;
+
+        // If true, the C functions pass their arguments to a shared invoker
+        // driven by per-method descriptors, instead of marshaling them inline.
+        public bool CompactInvokers;
+
+        // If true, the C functions can also be looked up and called by name
+        // at runtime through mono_embeddinator_invoke_dynamic.
+        public bool GenerateDynamicInvoke;
+
+        // GC parameters the runtime is started with, in the format of MONO_GC_PARAMS.
+        public string RuntimeGcParams;
+
+        // JIT optimizations the runtime is started with, in the format of
+        // the --optimize option of mono.
+        public string RuntimeJitOptimizations;
+
+        // If true, the runtime compiles methods with LLVM when it supports it.
+        public bool RuntimeUseLlvm;
+
+        // If true, the runtime starts without parsing its configuration file
+        // or probing for an app.config file.
+        public bool SkipRuntimeConfig;
+
+        public bool HasRuntimeOptions => RuntimeGcParams != null ||
+            RuntimeJitOptimizations != null || RuntimeUseLlvm || SkipRuntimeConfig;
     }
 }
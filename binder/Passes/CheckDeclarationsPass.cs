@@ -6,6 +6,7 @@ using CppSharp.AST;
 using CppSharp.Generators;
 using CppSharp.Passes;
 using CppSharp.AST.Extensions;
+using Embeddinator.Generators;
 
 namespace Embeddinator.Passes
 {
@@ -167,14 +168,57 @@ namespace Embeddinator.Passes
             if (duplicates.Count() == 0)
                 return;
 
-            // If all members that remain are methods, then we're done.
+            // If all members that remain are methods, only the overloads that
+            // end up with the same Java parameter types need to be handled.
             if (duplicates.All(d => d is Method))
+            {
+                HandleDuplicateSignaturesJava(duplicates.Cast<Method>());
                 return;
+            }
 
             if (duplicates.Count() > 1)
                 RenameDuplicates(duplicates);
         }
 
+        string GetJavaSignature(Method method)
+        {
+            var typePrinter = new JavaTypePrinter(Context);
+            var types = method.Parameters.Where(p => !p.IsImplicit)
+                .Select(p => typePrinter.VisitParameter(p, hasName: false).Type);
+
+            return string.Join(", ", types);
+        }
+
+        /// <summary>
+        /// Overloads only differing in the signedness of their integer types
+        /// have the same signature in Java, since unsigned values are carried
+        /// in signed types. Methods are renamed, and constructors ignored.
+        /// </summary>
+        void HandleDuplicateSignaturesJava(IEnumerable<Method> methods)
+        {
+            var overloads = methods.GroupBy(m =>
+                    $"{(m.IsConstructor ? "this" : m.Name)}({GetJavaSignature(m)})")
+                .Where(g => g.Count() > 1);
+
+            foreach (var overload in overloads)
+            {
+                var duplicates = overload.Skip(1).ToList();
+
+                if (!overload.First().IsConstructor)
+                {
+                    RenameDuplicates(duplicates);
+                    continue;
+                }
+
+                foreach (var duplicate in duplicates)
+                {
+                    duplicate.ExplicitlyIgnore();
+                    Diagnostics.Warning("Ignoring constructor {0} with the same Java signature as another overload",
+                        duplicate.QualifiedName);
+                }
+            }
+        }
+
         public override bool VisitParameterDecl(Parameter param)
         {
             return true;
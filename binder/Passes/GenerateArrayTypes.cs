@@ -44,7 +44,7 @@ namespace Embeddinator.Passes
             return ret;
         }
 
-        public static Class MonoEmbedArray = new Class { Name = "MonoEmbedArray", IsImplicit = true };
+        public static readonly Class MonoEmbedArray = new Class { Name = "MonoEmbedArray", IsImplicit = true };
 
         QualifiedType GenerateArrayType(ArrayType array, Declaration decl)
         {
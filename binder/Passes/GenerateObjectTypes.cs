@@ -94,7 +94,7 @@ namespace Embeddinator.Passes
                 AddObjectFieldsToClass(@class);
         }
         
-        public static Class MonoEmbedObject = new Class { Name = "MonoEmbedObject", IsImplicit = true };
+        public static readonly Class MonoEmbedObject = new Class { Name = "MonoEmbedObject", IsImplicit = true };
 
         void CreateTypedefObjectForClass(Class @class)
         {
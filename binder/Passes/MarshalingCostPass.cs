@@ -0,0 +1,369 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using System.Text;
+using CppSharp;
+using CppSharp.AST;
+using CppSharp.AST.Extensions;
+using CppSharp.Passes;
+using Embeddinator.Generators;
+
+namespace Embeddinator.Passes
+{
+    /// <summary>
+    /// Estimated work done on each call of a generated C binding, following
+    /// the code the C marshalers generate for its parameters and result.
+    /// </summary>
+    public class MarshalingCost
+    {
+        // Calls into managed code.
+        public int Transitions;
+
+        // Managed and native heap allocations.
+        public int Allocations;
+
+        // Value types boxed by the runtime, such as the results of mono_runtime_invoke.
+        public int Boxing;
+
+        // Strings and arrays copied across the boundary.
+        public int Copies;
+
+        // GC handles created for objects handed out to native code.
+        public int Handles;
+
+        // Arrays whose elements are marshaled one at a time, so their cost
+        // grows with their length.
+        public int PerElement;
+
+        // Objects read from their GC handles, and classes and virtual methods
+        // looked up at runtime.
+        public int Lookups;
+
+        public List<string> Notes = new List<string>();
+
+        public int Score => Transitions * 10 + Allocations * 5 + Boxing * 6 +
+            Copies * 2 + Handles * 8 + PerElement * 30 + Lookups * 3;
+    }
+
+    public class MarshalingCostEntry
+    {
+        public string Name;
+        public string ManagedName;
+        public MarshalingCost Cost;
+    }
+
+    /// <summary>
+    /// Estimates the marshaling cost of each generated method and property
+    /// accessor, so expensive signatures can be found before they ship.
+    /// </summary>
+    public class MarshalingCostPass : TranslationUnitPass
+    {
+        public const int DefaultThreshold = 30;
+
+        public int Threshold = DefaultThreshold;
+
+        public List<MarshalingCostEntry> Entries = new List<MarshalingCostEntry>();
+
+        readonly HashSet<Method> processed = new HashSet<Method>();
+
+        public override bool VisitMethodDecl(Method method)
+        {
+            if (!VisitDeclaration(method))
+                return false;
+
+            AddEntry(method);
+            return true;
+        }
+
+        public override bool VisitProperty(Property property)
+        {
+            if (!VisitDeclaration(property))
+                return false;
+
+            if (property.GetMethod != null)
+                AddEntry(property.GetMethod);
+
+            if (property.SetMethod != null)
+                AddEntry(property.SetMethod);
+
+            return true;
+        }
+
+        void AddEntry(Method method)
+        {
+            if (!method.IsGenerated || !processed.Add(method))
+                return;
+
+            Entries.Add(new MarshalingCostEntry
+            {
+                Name = CCodeGenerator.GetMethodIdentifier(method),
+                ManagedName = method.ManagedQualifiedName(),
+                Cost = Estimate(method)
+            });
+        }
+
+        /// <summary>
+        /// Gets the entries sorted from the most to the least expensive.
+        /// </summary>
+        public IEnumerable<MarshalingCostEntry> SortedEntries =>
+            Entries.OrderByDescending(e => e.Cost.Score).ThenBy(e => e.Name, StringComparer.Ordinal);
+
+        public MarshalingCost Estimate(Method method)
+        {
+            var cost = new MarshalingCost();
+
+            var constant = CCodeGenerator.GetConstantProperty(method);
+            if (constant != null && !constant.Type.IsPrimitiveType(PrimitiveType.String))
+            {
+                cost.Notes.Add("constant, does not call into the runtime");
+                return cost;
+            }
+
+            cost.Transitions++;
+
+            if (method.IsVirtual)
+            {
+                cost.Lookups++;
+                cost.Notes.Add("looks up the virtual method on each call");
+            }
+
+            if (method.IsConstructor)
+            {
+                // The managed object, its native wrapper and its GC handle.
+                cost.Allocations += 2;
+                cost.Handles++;
+            }
+            else if (!method.IsStatic)
+            {
+                // The instance is read from the handle of its native wrapper.
+                cost.Lookups++;
+            }
+
+            var index = 0;
+            foreach (var param in method.Parameters.Where(p => !p.IsImplicit))
+                AddParameterCost(cost, param, index++);
+
+            if (!method.IsConstructor)
+                AddReturnCost(cost, method.ReturnType);
+
+            if (CCodeGenerator.IsMemoizable(method))
+                cost.Notes.Add("memoized, repeated calls with the same arguments are free");
+
+            if (CCodeGenerator.HasValueMethod(method))
+                cost.Notes.Add("the _value variant passes blittable structs without handles");
+
+            return cost;
+        }
+
+        // The costs of the calls made by the code of the C marshalers.
+        static readonly Dictionary<string, Action<MarshalingCost>> CallCosts =
+            new Dictionary<string, Action<MarshalingCost>>
+        {
+            { "mono_string_new(", cost => { cost.Allocations++; cost.Copies++; } },
+            { "mono_string_to_utf8(", cost => { cost.Allocations++; cost.Copies++; } },
+            { "mono_embeddinator_marshal_string_to_gstring(", cost => { cost.Allocations++; cost.Copies++; } },
+            { "mono_array_new(", cost => cost.Allocations++ },
+            { "g_array_sized_new(", cost => cost.Allocations++ },
+            { "memcpy(", cost => cost.Copies++ },
+            { "g_array_append_vals(", cost => cost.Copies++ },
+            { "mono_value_box(", cost => { cost.Boxing++; cost.Allocations++; } },
+            { "mono_embeddinator_create_object(", cost => { cost.Allocations++; cost.Handles++; } },
+            { "mono_embeddinator_iterator_new(", cost => { cost.Allocations++; cost.Handles++; } },
+            { "mono_embeddinator_future_new(", cost => { cost.Allocations++; cost.Handles++; } },
+            { "mono_embeddinator_stream_new(", cost => { cost.Allocations++; cost.Handles++; } },
+            { "mono_gchandle_get_target(", cost => cost.Lookups++ },
+            { "mono_embeddinator_stream_get_object(", cost => cost.Lookups++ },
+            { "mono_embeddinator_search_class(", cost => cost.Lookups++ },
+            { "mono_class_from_name(", cost => cost.Lookups++ },
+        };
+
+        static int CountOccurrences(string code, string value)
+        {
+            var count = 0;
+            for (var i = code.IndexOf(value, StringComparison.Ordinal); i >= 0;
+                i = code.IndexOf(value, i + value.Length, StringComparison.Ordinal))
+                count++;
+            return count;
+        }
+
+        /// <summary>
+        /// Adds the costs of the calls made by some generated marshaling code.
+        /// </summary>
+        static void AddCodeCost(MarshalingCost cost, string code, string subject)
+        {
+            foreach (var call in CallCosts)
+            {
+                var count = CountOccurrences(code, call.Key);
+                for (var i = 0; i < count; i++)
+                    call.Value(cost);
+            }
+
+            var loops = CountOccurrences(code, "for (");
+            if (loops > 0)
+            {
+                cost.PerElement += loops;
+                cost.Notes.Add($"{subject} marshaled one at a time");
+            }
+        }
+
+        /// <summary>
+        /// Estimates the cost of a parameter from the code the C generator
+        /// marshals it with.
+        /// </summary>
+        void AddParameterCost(MarshalingCost cost, Parameter param, int index)
+        {
+            var marshal = new CMarshalNativeToManaged(Context)
+            {
+                ArgName = param.Name,
+                Parameter = param,
+                ParameterIndex = index
+            };
+
+            param.Visit(marshal);
+
+            var code = $"{marshal.Before}{marshal.Return}{marshal.After}{marshal.Cleanup}";
+            AddCodeCost(cost, code, $"'{param.Name}' has its elements");
+
+            if (code.Contains("mono_embeddinator_string_cache_lookup("))
+                cost.Notes.Add($"'{param.Name}' is looked up in the string cache");
+
+            if (code.Contains("mono_embeddinator_array_lend("))
+                cost.Notes.Add($"'{param.Name}' reuses a lent managed array");
+
+            if (marshal.After.ToString().Contains("mono_embeddinator_create_object("))
+                cost.Notes.Add($"'{param.Name}' may create a handle for the returned object");
+        }
+
+        /// <summary>
+        /// Estimates the cost of a result from the code the C generator marshals
+        /// it with.
+        /// </summary>
+        void AddReturnCost(MarshalingCost cost, QualifiedType returnType)
+        {
+            var type = returnType.Type;
+            if (type.IsPrimitiveType(PrimitiveType.Void))
+                return;
+
+            var marshal = new CMarshalManagedToNative(Context)
+            {
+                ArgName = "result",
+                ReturnVarName = "result",
+                ReturnType = returnType
+            };
+
+            returnType.Visit(marshal);
+
+            AddCodeCost(cost, $"{marshal.Before}{marshal.Return}", "returns elements");
+
+            // mono_runtime_invoke returns value types boxed.
+            if (CMarshalNativeToManaged.IsValueType(type))
+            {
+                cost.Boxing++;
+                cost.Allocations++;
+
+                Class @class;
+                if (type.TryGetClass(out @class) && @class.IsValueType)
+                    cost.Notes.Add($"returns the {@class.Name} struct boxed");
+            }
+        }
+
+        static string EscapeJson(string value)
+        {
+            var builder = new StringBuilder();
+            foreach (var c in value)
+            {
+                switch (c)
+                {
+                case '"':
+                    builder.Append("\\\"");
+                    break;
+                case '\\':
+                    builder.Append("\\\\");
+                    break;
+                default:
+                    if (c < ' ')
+                        builder.AppendFormat(CultureInfo.InvariantCulture, "\\u{0:x4}", (int)c);
+                    else
+                        builder.Append(c);
+                    break;
+                }
+            }
+            return builder.ToString();
+        }
+
+        public string ToJson()
+        {
+            var builder = new StringBuilder();
+            builder.AppendLine("{");
+            builder.AppendLine($"  \"threshold\": {Threshold},");
+            builder.AppendLine("  \"bindings\": [");
+
+            var entries = SortedEntries.ToList();
+            for (var i = 0; i < entries.Count; i++)
+            {
+                var entry = entries[i];
+                var cost = entry.Cost;
+                var notes = string.Join(", ", cost.Notes.Select(n => $"\"{EscapeJson(n)}\""));
+
+                builder.AppendLine("    {");
+                builder.AppendLine($"      \"name\": \"{EscapeJson(entry.Name)}\",");
+                builder.AppendLine($"      \"managed\": \"{EscapeJson(entry.ManagedName)}\",");
+                builder.AppendLine($"      \"score\": {cost.Score},");
+                builder.AppendLine($"      \"transitions\": {cost.Transitions},");
+                builder.AppendLine($"      \"allocations\": {cost.Allocations},");
+                builder.AppendLine($"      \"boxing\": {cost.Boxing},");
+                builder.AppendLine($"      \"copies\": {cost.Copies},");
+                builder.AppendLine($"      \"handles\": {cost.Handles},");
+                builder.AppendLine($"      \"perElement\": {cost.PerElement},");
+                builder.AppendLine($"      \"lookups\": {cost.Lookups},");
+                builder.AppendLine($"      \"notes\": [{notes}]");
+                builder.AppendLine(i < entries.Count - 1 ? "    }," : "    }");
+            }
+
+            builder.AppendLine("  ]");
+            builder.AppendLine("}");
+            return builder.ToString();
+        }
+
+        public string ToText()
+        {
+            var entries = SortedEntries.ToList();
+            var nameWidth = Math.Max("Binding".Length, entries.Select(e => e.Name.Length)
+                .DefaultIfEmpty(0).Max());
+
+            var builder = new StringBuilder();
+            builder.AppendLine($"Estimated marshaling cost per call (warning threshold: {Threshold})");
+            builder.AppendLine();
+            builder.AppendLine(string.Format(CultureInfo.InvariantCulture,
+                "{0} {1,5} {2,5} {3,5} {4,5} {5,5} {6,5} {7,5} {8,5}", "Binding".PadRight(nameWidth),
+                "Score", "Trans", "Alloc", "Box", "Copy", "Handl", "Elem", "Look"));
+
+            foreach (var entry in entries)
+            {
+                var cost = entry.Cost;
+                builder.AppendLine(string.Format(CultureInfo.InvariantCulture,
+                    "{0} {1,5} {2,5} {3,5} {4,5} {5,5} {6,5} {7,5} {8,5}{9}", entry.Name.PadRight(nameWidth),
+                    cost.Score, cost.Transitions, cost.Allocations, cost.Boxing, cost.Copies,
+                    cost.Handles, cost.PerElement, cost.Lookups, cost.Score >= Threshold ? " !" : string.Empty));
+
+                foreach (var note in cost.Notes)
+                    builder.AppendLine($"    {note}");
+            }
+
+            return builder.ToString();
+        }
+
+        /// <summary>
+        /// Warns about the bindings whose cost reaches the threshold.
+        /// </summary>
+        public void WarnAboveThreshold()
+        {
+            foreach (var entry in SortedEntries.Where(e => e.Cost.Score >= Threshold))
+            {
+                Diagnostics.Warning("Binding '{0}' has an estimated marshaling cost of {1} (threshold {2})",
+                    entry.ManagedName, entry.Cost.Score, Threshold);
+            }
+        }
+    }
+}
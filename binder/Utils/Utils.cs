@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
+using System.Security.Cryptography;
 using System.Text;
 using CppSharp;
 
@@ -113,6 +114,22 @@ namespace Embeddinator
             throw new Exception($"Cannot find {Path.GetFileName(dir)}!");
         }
 
+        /// <summary>
+        /// Computes the SHA-256 hash of a stream as a lowercase hex string.
+        /// </summary>
+        public static string ComputeHash(Stream stream)
+        {
+            using (var sha = SHA256.Create())
+            {
+                var hash = sha.ComputeHash(stream);
+                return BitConverter.ToString(hash).Replace("-", string.Empty).ToLowerInvariant();
+            }
+        }
+
+        // Processes can be invoked from multiple threads, so their output is
+        // logged under a lock to keep the diagnostics indentation consistent.
+        static readonly object invokeLogLock = new object();
+
         public static ProcessOutput Invoke(string program, string arguments, Dictionary<string, string> envVars = null)
         {
             var process = new Process
@@ -156,13 +173,16 @@ namespace Embeddinator
                 StandardError = standardError.ToString()
             };
 
-            Diagnostics.Debug("Invoking: {0} {1}", program, arguments);
-            Diagnostics.PushIndent();
-            if (standardOut.Length > 0)
-                Diagnostics.Message("{0}", standardOut.ToString());
-            if (standardError.Length > 0)
-                Diagnostics.Message("{0}", standardError.ToString());
-            Diagnostics.PopIndent();
+            lock (invokeLogLock)
+            {
+                Diagnostics.Debug("Invoking: {0} {1}", program, arguments);
+                Diagnostics.PushIndent();
+                if (standardOut.Length > 0)
+                    Diagnostics.Message("{0}", standardOut.ToString());
+                if (standardError.Length > 0)
+                    Diagnostics.Message("{0}", standardError.ToString());
+                Diagnostics.PopIndent();
+            }
 
             return output;
         }
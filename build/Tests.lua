@@ -182,10 +182,10 @@ function SetupTestProjectsRunner(name)
     dependson { name .. ".Managed" }
 
     filter { "not system:windows", "files:*.cpp" }
-      buildoptions { "-std=gnu++11" }
+      buildoptions { "-std=gnu++17" }
 
     filter { "action:vs*" }
-      buildoptions { "/wd4018" } -- eglib signed/unsigned warnings
+      buildoptions { "/wd4018", "/std:c++latest" } -- eglib signed/unsigned warnings
 
     filter {}  
 end
@@ -25,6 +25,43 @@
 
 #include "c-support.h"
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/**
+ * Locks
+ */
+#ifdef _WIN32
+typedef SRWLOCK mono_embeddinator_lock_t;
+#define mono_embeddinator_lock_init(lock) InitializeSRWLock(lock)
+#define mono_embeddinator_lock(lock) AcquireSRWLockExclusive(lock)
+#define mono_embeddinator_unlock(lock) ReleaseSRWLockExclusive(lock)
+
+typedef INIT_ONCE mono_embeddinator_once_t;
+#define MONO_EMBEDDINATOR_ONCE_INIT INIT_ONCE_STATIC_INIT
+
+static BOOL CALLBACK mono_embeddinator_once_callback(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+    ((void (*)()) param)();
+    return TRUE;
+}
+
+#define mono_embeddinator_once(once, func) \
+    InitOnceExecuteOnce(once, mono_embeddinator_once_callback, (PVOID) func, NULL)
+#else
+typedef pthread_mutex_t mono_embeddinator_lock_t;
+#define mono_embeddinator_lock_init(lock) pthread_mutex_init(lock, NULL)
+#define mono_embeddinator_lock(lock) pthread_mutex_lock(lock)
+#define mono_embeddinator_unlock(lock) pthread_mutex_unlock(lock)
+
+typedef pthread_once_t mono_embeddinator_once_t;
+#define MONO_EMBEDDINATOR_ONCE_INIT PTHREAD_ONCE_INIT
+#define mono_embeddinator_once(once, func) pthread_once(once, func)
+#endif
+
 GString* mono_embeddinator_decimal_to_gstring (MonoDecimal decimal)
 {
     static MonoMethod* tostringmethod = 0;
@@ -72,6 +109,18 @@ MonoDecimal mono_embeddinator_string_to_decimal (const char * number)
     return mdecimal;
 }
 
+void mono_embeddinator_string_free(char* string)
+{
+    if (string)
+        mono_free(string);
+}
+
+void mono_embeddinator_array_free(MonoEmbedArray array)
+{
+    if (array.array)
+        g_array_free(array.array, TRUE);
+}
+
 void mono_embeddinator_marshal_string_to_gstring(GString* g_string, MonoString* mono_string)
 {
     if (!mono_string)
@@ -80,6 +129,1431 @@ void mono_embeddinator_marshal_string_to_gstring(GString* g_string, MonoString*
         return;
     }
     
+    char* utf8 = mono_string_to_utf8(mono_string);
+
     g_string_truncate(g_string, 0);
-    g_string_append(g_string, mono_string_to_utf8((MonoString*) mono_string));
-}
\ No newline at end of file
+    g_string_append(g_string, utf8);
+
+    mono_free(utf8);
+}
+
+/**
+ * One-time initialization
+ *
+ * The flag is set with release semantics once the function returned, and read
+ * with acquire semantics, so a caller seeing it set also sees what the
+ * function initialized. A single lock serializes the first calls, the
+ * functions only look up classes and methods so they do not wait on others.
+ */
+static mono_embeddinator_lock_t init_lock;
+static mono_embeddinator_once_t init_lock_once = MONO_EMBEDDINATOR_ONCE_INIT;
+
+static void init_lock_init()
+{
+    mono_embeddinator_lock_init(&init_lock);
+}
+
+static mono_embeddinator_init_flag_t init_flag_load(volatile mono_embeddinator_init_flag_t* flag)
+{
+#ifdef _WIN32
+    return InterlockedCompareExchange((volatile LONG*) flag, 0, 0);
+#else
+    return __atomic_load_n(flag, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void init_flag_store(volatile mono_embeddinator_init_flag_t* flag)
+{
+#ifdef _WIN32
+    InterlockedExchange((volatile LONG*) flag, 1);
+#else
+    __atomic_store_n(flag, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+void mono_embeddinator_init_once(volatile mono_embeddinator_init_flag_t* flag, void (*init)())
+{
+    if (init_flag_load(flag))
+        return;
+
+    mono_embeddinator_once(&init_lock_once, init_lock_init);
+    mono_embeddinator_lock(&init_lock);
+
+    if (!*flag)
+    {
+        init();
+        init_flag_store(flag);
+    }
+
+    mono_embeddinator_unlock(&init_lock);
+}
+
+/**
+ * String cache
+ *
+ * Each set is guarded by its own lock so concurrent callers only contend when
+ * their strings hash to the same set. Ways inside a set are kept in most
+ * recently used order, the last way is the one evicted.
+ *
+ * Callers usually pass the same buffer (a literal or a long lived key) on every
+ * call, so each thread also remembers the hash and length last computed for a
+ * given pointer. A pointer hit only selects the set and way to compare against,
+ * the contents are still compared so a reused buffer is never mistaken.
+ */
+#define STRING_CACHE_SETS 256
+#define STRING_CACHE_WAYS 4
+#define STRING_CACHE_MAX_LENGTH 128
+#define STRING_CACHE_HINTS 64
+
+typedef struct
+{
+    const char* str;
+    uint32_t hash;
+    uint32_t length;
+} string_cache_hint_t;
+
+static MONO_EMBEDDINATOR_THREAD_LOCAL string_cache_hint_t string_cache_hints[STRING_CACHE_HINTS];
+
+typedef struct
+{
+    MonoDomain* domain;
+    uint32_t hash;
+    uint32_t length;
+    uint32_t handle;
+    char* str;
+} string_cache_entry_t;
+
+typedef struct
+{
+    mono_embeddinator_lock_t lock;
+    string_cache_entry_t ways[STRING_CACHE_WAYS];
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} string_cache_set_t;
+
+static string_cache_set_t string_cache[STRING_CACHE_SETS];
+
+static mono_embeddinator_once_t string_cache_once = MONO_EMBEDDINATOR_ONCE_INIT;
+
+static void string_cache_init()
+{
+    for (int i = 0; i < STRING_CACHE_SETS; i++)
+        mono_embeddinator_lock_init(&string_cache[i].lock);
+}
+
+static mono_embeddinator_lock_t* string_cache_set_lock(int set)
+{
+    mono_embeddinator_once(&string_cache_once, string_cache_init);
+    return &string_cache[set].lock;
+}
+
+static void string_cache_entry_free(string_cache_entry_t* entry)
+{
+    if (!entry->str)
+        return;
+
+    mono_gchandle_free(entry->handle);
+    free(entry->str);
+    memset(entry, 0, sizeof(string_cache_entry_t));
+}
+
+// Returns the cached string matching the given one and moves it to the front
+// of its set, or NULL. Must be called with the lock of the set held.
+static MonoString* string_cache_find(string_cache_set_t* set, MonoDomain* domain,
+    const char* str, uint32_t hash, uint32_t length)
+{
+    for (int i = 0; i < STRING_CACHE_WAYS; i++)
+    {
+        string_cache_entry_t* entry = &set->ways[i];
+        // Comparing the terminator too stops early on a hinted buffer that
+        // now holds a shorter string.
+        if (!entry->str || entry->hash != hash || entry->length != length ||
+            entry->domain != domain || strncmp(entry->str, str, length + 1) != 0)
+            continue;
+
+        string_cache_entry_t hit = *entry;
+        memmove(&set->ways[1], &set->ways[0], i * sizeof(string_cache_entry_t));
+        set->ways[0] = hit;
+        set->hits++;
+
+        return (MonoString*) mono_gchandle_get_target(hit.handle);
+    }
+
+    return 0;
+}
+
+MonoString* mono_embeddinator_string_cache_lookup(MonoDomain* domain, const char* str)
+{
+    if (!str)
+        return 0;
+
+    string_cache_hint_t* hint = &string_cache_hints[((uintptr_t) str >> 3) & (STRING_CACHE_HINTS - 1)];
+
+    uint32_t hash = hint->hash;
+    uint32_t length = hint->length;
+    bool hinted = hint->str == str;
+
+    if (!hinted)
+    {
+        // FNV-1a, computing the length at the same time.
+        hash = 2166136261u;
+        length = 0;
+        for (const unsigned char* p = (const unsigned char*) str; *p; p++, length++)
+        {
+            if (length == STRING_CACHE_MAX_LENGTH)
+                return mono_string_new(domain, str);
+
+            hash = (hash ^ *p) * 16777619u;
+        }
+
+        hint->str = str;
+        hint->hash = hash;
+        hint->length = length;
+    }
+
+    int index = hash & (STRING_CACHE_SETS - 1);
+    string_cache_set_t* set = &string_cache[index];
+    mono_embeddinator_lock_t* lock = string_cache_set_lock(index);
+
+    mono_embeddinator_lock(lock);
+    MonoString* cached = string_cache_find(set, domain, str, hash, length);
+    mono_embeddinator_unlock(lock);
+
+    if (cached)
+        return cached;
+
+    if (hinted)
+    {
+        // The buffer was rewritten since it was hashed, start over.
+        hint->str = 0;
+        return mono_embeddinator_string_cache_lookup(domain, str);
+    }
+
+    // Allocate the new entry before taking the lock again, another thread
+    // may have added the same string meanwhile, in which case it is dropped.
+    MonoString* mono_string = mono_string_new(domain, str);
+
+    string_cache_entry_t entry;
+    entry.domain = domain;
+    entry.hash = hash;
+    entry.length = length;
+    entry.handle = mono_gchandle_new((MonoObject*) mono_string, /*pinned=*/false);
+    entry.str = (char*) malloc(length + 1);
+    memcpy(entry.str, str, length + 1);
+
+    mono_embeddinator_lock(lock);
+
+    cached = string_cache_find(set, domain, str, hash, length);
+    if (cached)
+    {
+        mono_embeddinator_unlock(lock);
+        string_cache_entry_free(&entry);
+        return cached;
+    }
+
+    set->misses++;
+
+    string_cache_entry_t evicted = set->ways[STRING_CACHE_WAYS - 1];
+    if (evicted.str)
+        set->evictions++;
+
+    memmove(&set->ways[1], &set->ways[0], (STRING_CACHE_WAYS - 1) * sizeof(string_cache_entry_t));
+    set->ways[0] = entry;
+
+    mono_embeddinator_unlock(lock);
+
+    string_cache_entry_free(&evicted);
+
+    return mono_string;
+}
+
+void mono_embeddinator_string_cache_clear()
+{
+    for (int i = 0; i < STRING_CACHE_SETS; i++)
+    {
+        mono_embeddinator_lock_t* lock = string_cache_set_lock(i);
+        mono_embeddinator_lock(lock);
+
+        for (int j = 0; j < STRING_CACHE_WAYS; j++)
+            string_cache_entry_free(&string_cache[i].ways[j]);
+
+        mono_embeddinator_unlock(lock);
+    }
+}
+
+MonoEmbedStringView mono_embeddinator_string_view_new(MonoString* mono_string)
+{
+    MonoEmbedStringView view = { 0, 0, 0 };
+    if (!mono_string)
+        return view;
+
+    view.handle = mono_gchandle_new((MonoObject*) mono_string, /*pinned=*/TRUE);
+    view.chars = (const uint16_t*) mono_string_chars(mono_string);
+    view.len = mono_string_length(mono_string);
+
+    return view;
+}
+
+void mono_embeddinator_string_view_release(MonoEmbedStringView* view)
+{
+    if (view->handle)
+        mono_gchandle_free(view->handle);
+
+    view->chars = 0;
+    view->len = 0;
+    view->handle = 0;
+}
+
+/**
+ * Lent arrays
+ *
+ * Each thread keeps its own slots, a slot only holds a weak reference to the
+ * last array it lent so an idle array can still be collected.
+ */
+#define LENT_ARRAY_SLOTS 8
+
+typedef struct
+{
+    uint32_t handle;
+    int32_t depth;
+    MonoDomain* domain;
+    MonoClass* element_class;
+    uintptr_t length;
+} lent_array_t;
+
+static MONO_EMBEDDINATOR_THREAD_LOCAL lent_array_t lent_arrays[LENT_ARRAY_SLOTS];
+
+static volatile uint64_t lent_array_reuses;
+
+MonoArray* mono_embeddinator_array_lend(MonoDomain* domain, MonoClass* element_class,
+    uintptr_t length, int slot)
+{
+    if (slot < 0 || slot >= LENT_ARRAY_SLOTS)
+        return mono_array_new(domain, element_class, length);
+
+    lent_array_t* lent = &lent_arrays[slot];
+    if (lent->depth++ > 0)
+        return mono_array_new(domain, element_class, length);
+
+    if (lent->handle && lent->domain == domain && lent->element_class == element_class &&
+        lent->length == length)
+    {
+        MonoArray* array = (MonoArray*) mono_gchandle_get_target(lent->handle);
+        if (array)
+        {
+#ifdef _WIN32
+            InterlockedIncrement64((volatile LONG64*) &lent_array_reuses);
+#else
+            __sync_fetch_and_add(&lent_array_reuses, 1);
+#endif
+            return array;
+        }
+    }
+
+    if (lent->handle)
+        mono_gchandle_free(lent->handle);
+
+    MonoArray* array = mono_array_new(domain, element_class, length);
+
+    lent->handle = mono_gchandle_new_weakref((MonoObject*) array, /*track_resurrection=*/false);
+    lent->domain = domain;
+    lent->element_class = element_class;
+    lent->length = length;
+
+    return array;
+}
+
+void mono_embeddinator_array_return(int slot)
+{
+    if (slot >= 0 && slot < LENT_ARRAY_SLOTS)
+        lent_arrays[slot].depth--;
+}
+
+/**
+ * Iterators
+ *
+ * Arrays are read straight from their storage, so filling a chunk does not
+ * transition into managed code. Other collections implementing ICollection<T>
+ * are copied into an array with a single CopyTo call when the iterator is
+ * created. Any other sequence is copied into a List<T> with a single AddRange
+ * call, so no sequence costs managed calls per element.
+ */
+struct MonoEmbedIterator
+{
+    mono_embeddinator_iterator_kind_t kind;
+    MonoClass* element_class;
+    int32_t element_size;
+
+    /* Backing array, next element and number of elements. */
+    uint32_t array;
+    int32_t index;
+    int32_t length;
+
+    /* UTF-8 strings handed out by the last chunk. */
+    char** strings;
+    int32_t strings_count;
+    int32_t strings_capacity;
+};
+
+// Classes can implement ICollection<T> for several element types, so the
+// interfaces are matched on the element type of their CopyTo method.
+static MonoClass* iterator_collection_element_class(MonoClass* iface)
+{
+    MonoMethod* copy_to = mono_class_get_method_from_name(iface, "CopyTo", 2);
+    if (!copy_to)
+        return 0;
+
+    void* iter = 0;
+    MonoType* array_type = mono_signature_get_params(mono_method_signature(copy_to), &iter);
+    return mono_class_get_element_class(mono_class_from_mono_type(array_type));
+}
+
+static MonoClass* iterator_find_collection_interface(MonoClass* klass, MonoClass* element_class)
+{
+    for (; klass; klass = mono_class_get_parent(klass))
+    {
+        void* iter = 0;
+        MonoClass* iface;
+        while ((iface = mono_class_get_interfaces(klass, &iter)))
+        {
+            if (strcmp(mono_class_get_name(iface), "ICollection`1") == 0 &&
+                strcmp(mono_class_get_namespace(iface), "System.Collections.Generic") == 0 &&
+                iterator_collection_element_class(iface) == element_class)
+                return iface;
+        }
+    }
+
+    return 0;
+}
+
+static void iterator_set_array(MonoEmbedIterator* iterator, MonoArray* array)
+{
+    iterator->array = mono_gchandle_new((MonoObject*) array, /*pinned=*/false);
+    iterator->length = (int32_t) mono_array_length(array);
+}
+
+static bool iterator_init_collection(MonoEmbedIterator* iterator, MonoObject* collection,
+    MonoObject** exception)
+{
+    MonoClass* iface = iterator_find_collection_interface(mono_object_get_class(collection),
+        iterator->element_class);
+    if (!iface)
+        return false;
+
+    MonoMethod* get_count = mono_class_get_method_from_name(iface, "get_Count", 0);
+    MonoMethod* copy_to = mono_class_get_method_from_name(iface, "CopyTo", 2);
+    if (!get_count || !copy_to)
+        return false;
+
+    MonoObject* count = mono_runtime_invoke(mono_object_get_virtual_method(collection,
+        get_count), collection, 0, exception);
+    if (*exception)
+        return true;
+
+    int32_t length = *(int32_t*) mono_object_unbox(count);
+    MonoArray* array = mono_array_new(mono_object_get_domain(collection),
+        iterator->element_class, length);
+
+    // CopyTo throws if the collection grew since it was counted.
+    int32_t index = 0;
+    void* args[2] = { array, &index };
+    mono_runtime_invoke(mono_object_get_virtual_method(collection, copy_to),
+        collection, args, exception);
+    if (*exception)
+        return true;
+
+    iterator_set_array(iterator, array);
+    return true;
+}
+
+// Sequences implementing IEnumerable<T> for a derived element type are
+// accepted by AddRange as well, IEnumerable<T> being covariant.
+static void iterator_init_sequence(MonoEmbedIterator* iterator, MonoObject* sequence,
+    MonoObject** exception)
+{
+    MonoClass* list_definition = mono_class_from_name(mono_get_corlib(),
+        "System.Collections.Generic", "List`1");
+    MonoType* element_type = mono_class_get_type(iterator->element_class);
+    MonoClass* list_class = mono_class_bind_generic_parameters(list_definition, 1,
+        &element_type, /*is_dynamic=*/false);
+
+    MonoObject* list = mono_object_new(mono_object_get_domain(sequence), list_class);
+    mono_runtime_invoke(mono_class_get_method_from_name(list_class, ".ctor", 0), list, 0,
+        exception);
+    if (*exception)
+        return;
+
+    void* args[1] = { sequence };
+    mono_runtime_invoke(mono_class_get_method_from_name(list_class, "AddRange", 1), list,
+        args, exception);
+    if (*exception)
+        return;
+
+    MonoObject* array = mono_runtime_invoke(mono_class_get_method_from_name(list_class,
+        "ToArray", 0), list, 0, exception);
+    if (*exception)
+        return;
+
+    iterator_set_array(iterator, (MonoArray*) array);
+}
+
+MonoEmbedIterator* mono_embeddinator_iterator_new(MonoObject* collection,
+    MonoClass* element_class, mono_embeddinator_iterator_kind_t kind)
+{
+    if (!collection)
+        return 0;
+
+    MonoEmbedIterator* iterator = g_new0(MonoEmbedIterator, 1);
+    iterator->kind = kind;
+    iterator->element_class = element_class;
+    iterator->element_size = kind == MONO_EMBEDDINATOR_ITERATOR_VALUE ?
+        mono_class_array_element_size(element_class) : sizeof(void*);
+
+    MonoClass* klass = mono_object_get_class(collection);
+    if (mono_class_get_rank(klass) == 1)
+    {
+        iterator_set_array(iterator, (MonoArray*) collection);
+        return iterator;
+    }
+
+    MonoObject* exception = 0;
+    if (!iterator_init_collection(iterator, collection, &exception) && !exception)
+        iterator_init_sequence(iterator, collection, &exception);
+
+    if (!exception)
+        return iterator;
+
+    mono_embeddinator_throw_exception(exception);
+    mono_embeddinator_iterator_destroy(iterator);
+    return 0;
+}
+
+static void iterator_free_strings(MonoEmbedIterator* iterator)
+{
+    for (int i = 0; i < iterator->strings_count; i++)
+        mono_free(iterator->strings[i]);
+
+    iterator->strings_count = 0;
+}
+
+static void iterator_store_reference(MonoEmbedIterator* iterator, void** dest,
+    MonoObject* element)
+{
+    if (!element)
+    {
+        *dest = 0;
+        return;
+    }
+
+    if (iterator->kind == MONO_EMBEDDINATOR_ITERATOR_OBJECT)
+    {
+        *dest = mono_embeddinator_create_object(element);
+        return;
+    }
+
+    char* string = mono_string_to_utf8((MonoString*) element);
+    iterator->strings[iterator->strings_count++] = string;
+    *dest = string;
+}
+
+static int32_t iterator_next_array(MonoEmbedIterator* iterator, char* buffer,
+    int32_t capacity)
+{
+    int32_t count = iterator->length - iterator->index;
+    if (count > capacity)
+        count = capacity;
+
+    MonoArray* array = (MonoArray*) mono_gchandle_get_target(iterator->array);
+    char* src = mono_array_addr_with_size(array, iterator->element_size, iterator->index);
+
+    if (iterator->kind == MONO_EMBEDDINATOR_ITERATOR_VALUE)
+        memcpy(buffer, src, (size_t) count * iterator->element_size);
+    else
+    {
+        for (int i = 0; i < count; i++)
+            iterator_store_reference(iterator, (void**) buffer + i, ((MonoObject**) src)[i]);
+    }
+
+    iterator->index += count;
+    return count;
+}
+
+int32_t mono_embeddinator_iterator_next(MonoEmbedIterator* iterator, void* buffer,
+    int32_t capacity)
+{
+    iterator_free_strings(iterator);
+
+    if (capacity <= 0)
+        return 0;
+
+    if (iterator->kind == MONO_EMBEDDINATOR_ITERATOR_STRING &&
+        iterator->strings_capacity < capacity)
+    {
+        iterator->strings = g_renew(char*, iterator->strings, capacity);
+        iterator->strings_capacity = capacity;
+    }
+
+    return iterator_next_array(iterator, (char*) buffer, capacity);
+}
+
+int32_t mono_embeddinator_iterator_count(MonoEmbedIterator* iterator)
+{
+    return iterator->length;
+}
+
+void mono_embeddinator_iterator_destroy(MonoEmbedIterator* iterator)
+{
+    if (!iterator)
+        return;
+
+    iterator_free_strings(iterator);
+    g_free(iterator->strings);
+
+    if (iterator->array)
+        mono_gchandle_free(iterator->array);
+
+    g_free(iterator);
+}
+
+/**
+ * Futures
+ */
+struct MonoEmbedFuture
+{
+    uint32_t task;
+    bool has_result;
+};
+
+/* System.Threading.Tasks.TaskStatus */
+#define TASK_STATUS_RAN_TO_COMPLETION 5
+#define TASK_STATUS_CANCELED 6
+#define TASK_STATUS_FAULTED 7
+
+static MonoClass* task_class;
+static MonoMethod* task_get_status;
+static MonoMethod* task_wait;
+static MonoMethod* task_wait_timeout;
+static MonoMethod* task_wait_any;
+static MonoMethod* exception_get_inner;
+
+static mono_embeddinator_once_t task_once = MONO_EMBEDDINATOR_ONCE_INIT;
+
+static void task_init()
+{
+    task_class = mono_class_from_name(mono_get_corlib(), "System.Threading.Tasks", "Task");
+    task_get_status = mono_class_get_method_from_name(task_class, "get_Status", 0);
+    task_wait = mono_class_get_method_from_name(task_class, "Wait", 0);
+    task_wait_timeout = mono_embeddinator_lookup_method(
+        "System.Threading.Tasks.Task:Wait(int)", task_class);
+    task_wait_any = mono_embeddinator_lookup_method(
+        "System.Threading.Tasks.Task:WaitAny(System.Threading.Tasks.Task[],int)", task_class);
+
+    // Looked up on Exception, methods are not searched in parent classes.
+    MonoClass* exception_class = mono_class_from_name(mono_get_corlib(), "System", "Exception");
+    exception_get_inner = mono_class_get_method_from_name(exception_class, "get_InnerException", 0);
+}
+
+MonoEmbedFuture* mono_embeddinator_future_new(MonoObject* task, bool has_result)
+{
+    if (!task)
+        return 0;
+
+    mono_embeddinator_once(&task_once, task_init);
+
+    MonoEmbedFuture* future = g_new(MonoEmbedFuture, 1);
+    future->task = mono_gchandle_new(task, /*pinned=*/false);
+    future->has_result = has_result;
+
+    return future;
+}
+
+mono_embeddinator_future_status_t mono_embeddinator_future_status(MonoEmbedFuture* future)
+{
+    MonoObject* task = mono_gchandle_get_target(future->task);
+
+    MonoObject* exception = 0;
+    MonoObject* status = mono_runtime_invoke(task_get_status, task, 0, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        return MONO_EMBEDDINATOR_FUTURE_FAULTED;
+    }
+
+    switch (*(int32_t*) mono_object_unbox(status))
+    {
+    case TASK_STATUS_RAN_TO_COMPLETION:
+        return MONO_EMBEDDINATOR_FUTURE_COMPLETED;
+    case TASK_STATUS_CANCELED:
+        return MONO_EMBEDDINATOR_FUTURE_CANCELED;
+    case TASK_STATUS_FAULTED:
+        return MONO_EMBEDDINATOR_FUTURE_FAULTED;
+    default:
+        return MONO_EMBEDDINATOR_FUTURE_PENDING;
+    }
+}
+
+bool mono_embeddinator_future_is_completed(MonoEmbedFuture* future)
+{
+    return mono_embeddinator_future_status(future) != MONO_EMBEDDINATOR_FUTURE_PENDING;
+}
+
+bool mono_embeddinator_future_wait(MonoEmbedFuture* future, int32_t timeout)
+{
+    MonoObject* task = mono_gchandle_get_target(future->task);
+
+    void* args[1] = { &timeout };
+    MonoObject* exception = 0;
+    MonoObject* completed = mono_runtime_invoke(task_wait_timeout, task, args, &exception);
+
+    // Faulted and canceled tasks throw from Wait, but they are completed.
+    if (exception)
+        return true;
+
+    return *(uint8_t*) mono_object_unbox(completed);
+}
+
+int32_t mono_embeddinator_future_wait_any(MonoEmbedFuture** futures, int32_t count,
+    int32_t timeout)
+{
+    if (count <= 0)
+        return -1;
+
+    MonoDomain* domain = mono_domain_get();
+    MonoArray* tasks = mono_array_new(domain, task_class, count);
+    for (int i = 0; i < count; i++)
+        mono_array_setref(tasks, i, mono_gchandle_get_target(futures[i]->task));
+
+    void* args[2] = { tasks, &timeout };
+    MonoObject* exception = 0;
+    MonoObject* index = mono_runtime_invoke(task_wait_any, 0, args, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        return -1;
+    }
+
+    return *(int32_t*) mono_object_unbox(index);
+}
+
+static MonoMethod* future_get_result_method(MonoClass* klass)
+{
+    for (; klass && klass != task_class; klass = mono_class_get_parent(klass))
+    {
+        MonoMethod* method = mono_class_get_method_from_name(klass, "get_Result", 0);
+        if (method)
+            return method;
+    }
+
+    return 0;
+}
+
+MonoObject* mono_embeddinator_future_get_result(MonoEmbedFuture* future)
+{
+    MonoObject* task = mono_gchandle_get_target(future->task);
+
+    // Wait rethrows faults and cancellations wrapped in an AggregateException,
+    // report the inner exception the same way synchronous calls do.
+    MonoObject* exception = 0;
+    mono_runtime_invoke(task_wait, task, 0, &exception);
+    if (exception)
+    {
+        MonoObject* inner_exception = 0;
+        MonoObject* inner = mono_runtime_invoke(exception_get_inner, exception, 0, &inner_exception);
+
+        mono_embeddinator_throw_exception(inner && !inner_exception ? inner : exception);
+        return 0;
+    }
+
+    // Tasks without a result can still be Task<VoidTaskResult> at runtime,
+    // so this relies on the bound type instead of the class of the task.
+    if (!future->has_result)
+        return 0;
+
+    MonoMethod* get_result = future_get_result_method(mono_object_get_class(task));
+    if (!get_result)
+        return 0;
+
+    MonoObject* result = mono_runtime_invoke(get_result, task, 0, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        return 0;
+    }
+
+    return result;
+}
+
+void mono_embeddinator_future_destroy(MonoEmbedFuture* future)
+{
+    if (!future)
+        return;
+
+    mono_gchandle_free(future->task);
+    g_free(future);
+}
+
+/**
+ * Callbacks
+ *
+ * A slot holds its delegate with a strong handle while it is referenced, and
+ * with a weak handle once released so the same binding can be acquired again.
+ * The trampoline of a slot forwards to whatever function the slot is bound
+ * to, so a slot is only bound to another function once managed code can no
+ * longer reach its previous delegate, and a new delegate is created for it.
+ */
+static mono_embeddinator_lock_t callback_lock;
+static mono_embeddinator_once_t callback_once = MONO_EMBEDDINATOR_ONCE_INIT;
+static MonoMethod* get_delegate_for_function_pointer;
+
+static void callback_init()
+{
+    mono_embeddinator_lock_init(&callback_lock);
+
+    MonoClass* marshal_class = mono_class_from_name(mono_get_corlib(),
+        "System.Runtime.InteropServices", "Marshal");
+    get_delegate_for_function_pointer = mono_embeddinator_lookup_method(
+        "System.Runtime.InteropServices.Marshal:GetDelegateForFunctionPointer(intptr,System.Type)",
+        marshal_class);
+}
+
+static MonoObject* callback_create_delegate(MonoClass* delegate_class, void* trampoline)
+{
+    MonoDomain* domain = mono_domain_get();
+    MonoReflectionType* type = mono_type_get_object(domain, mono_class_get_type(delegate_class));
+
+    void* args[2] = { &trampoline, type };
+    MonoObject* exception = 0;
+    MonoObject* delegate = mono_runtime_invoke(get_delegate_for_function_pointer, 0, args, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        return 0;
+    }
+
+    return delegate;
+}
+
+// Returns the delegate of a slot, or NULL if it was never created or was
+// collected after the slot was released.
+static MonoObject* callback_slot_delegate(mono_embeddinator_callback_slot_t* slot)
+{
+    return slot->delegate ? mono_gchandle_get_target(slot->delegate) : 0;
+}
+
+static void callback_slot_set_delegate(mono_embeddinator_callback_slot_t* slot,
+    MonoObject* delegate, bool weak)
+{
+    if (slot->delegate)
+        mono_gchandle_free(slot->delegate);
+
+    slot->delegate = !delegate ? 0 : weak ?
+        mono_gchandle_new_weakref(delegate, /*track_resurrection=*/false) :
+        mono_gchandle_new(delegate, /*pinned=*/false);
+}
+
+MonoObject* mono_embeddinator_callback_acquire(mono_embeddinator_callback_pool_t* pool,
+    MonoClass* delegate_class, void* fn, void* context)
+{
+    mono_embeddinator_once(&callback_once, callback_init);
+
+    // Delegates are created without holding the lock, since that runs managed
+    // code. The slot is checked again before publishing the new delegate, and
+    // it is dropped if another thread bound the slot or the same function
+    // meanwhile.
+    mono_embeddinator_callback_slot_t* created_slot = 0;
+    MonoObject* created = 0;
+
+    for (;;)
+    {
+        mono_embeddinator_lock(&callback_lock);
+
+        mono_embeddinator_callback_slot_t* slot = 0;
+        MonoObject* delegate = 0;
+        for (int i = 0; i < pool->count; i++)
+        {
+            mono_embeddinator_callback_slot_t* candidate = &pool->slots[i];
+            MonoObject* candidate_delegate = callback_slot_delegate(candidate);
+
+            if (candidate_delegate && candidate->fn == fn && candidate->context == context)
+            {
+                slot = candidate;
+                delegate = candidate_delegate;
+                break;
+            }
+
+            if (!candidate_delegate && !slot)
+                slot = candidate;
+        }
+
+        if (!delegate && created && !callback_slot_delegate(created_slot))
+        {
+            slot = created_slot;
+            delegate = created;
+            slot->fn = fn;
+            slot->context = context;
+        }
+
+        if (delegate)
+        {
+            if (!slot->references)
+                callback_slot_set_delegate(slot, delegate, /*weak=*/false);
+
+            slot->references++;
+        }
+
+        mono_embeddinator_unlock(&callback_lock);
+
+        if (delegate)
+            return delegate;
+
+        if (!slot)
+            break;
+
+        created_slot = slot;
+        created = callback_create_delegate(delegate_class, pool->trampolines[slot - pool->slots]);
+        if (!created)
+            return 0;
+    }
+
+    mono_embeddinator_error_t error;
+    error.type = MONO_EMBEDDINATOR_CALLBACK_SLOTS_EXHAUSTED;
+    error.exception = 0;
+    error.string = mono_class_get_name(delegate_class);
+    mono_embeddinator_error(error);
+
+    return 0;
+}
+
+void mono_embeddinator_callback_release(mono_embeddinator_callback_pool_t* pool,
+    MonoObject* delegate)
+{
+    mono_embeddinator_once(&callback_once, callback_init);
+    mono_embeddinator_lock(&callback_lock);
+
+    for (int i = 0; i < pool->count; i++)
+    {
+        mono_embeddinator_callback_slot_t* slot = &pool->slots[i];
+        if (slot->references && callback_slot_delegate(slot) == delegate)
+        {
+            if (!--slot->references)
+                callback_slot_set_delegate(slot, delegate, /*weak=*/true);
+            break;
+        }
+    }
+
+    mono_embeddinator_unlock(&callback_lock);
+}
+
+/**
+ * Streams
+ *
+ * Buffers are pinned for their whole lifetime so their storage address can be
+ * cached and copied to or from without looking it up again.
+ *
+ * The overrides of a stream are called through unmanaged thunks, which return
+ * the counts and positions by value instead of boxing each of them like
+ * mono_runtime_invoke does.
+ */
+#define STREAM_BUFFER_SIZE (64 * 1024)
+#define STREAM_BUFFER_POOL_SIZE 8
+
+typedef struct
+{
+    uint32_t handle;
+    MonoArray* array;
+    char* data;
+} stream_buffer_t;
+
+typedef int32_t (*stream_read_fn)(MonoObject* stream, MonoArray* buffer, int32_t offset,
+    int32_t count, MonoException** exception);
+typedef void (*stream_write_fn)(MonoObject* stream, MonoArray* buffer, int32_t offset,
+    int32_t count, MonoException** exception);
+typedef int64_t (*stream_seek_fn)(MonoObject* stream, int64_t offset, int32_t origin,
+    MonoException** exception);
+typedef int64_t (*stream_get_length_fn)(MonoObject* stream, MonoException** exception);
+typedef void (*stream_flush_fn)(MonoObject* stream, MonoException** exception);
+
+struct MonoEmbedStream
+{
+    uint32_t stream;
+    stream_read_fn read;
+    stream_write_fn write;
+    stream_seek_fn seek;
+    stream_get_length_fn get_length;
+    stream_flush_fn flush;
+};
+
+static stream_buffer_t stream_buffers[STREAM_BUFFER_POOL_SIZE];
+static int stream_buffers_count;
+static uint64_t stream_buffer_allocations;
+static mono_embeddinator_lock_t stream_lock;
+
+static MonoClass* stream_class;
+static MonoClass* unmanaged_memory_stream_class;
+static MonoMethod* unmanaged_memory_stream_ctor;
+static MonoMethod* stream_read;
+static MonoMethod* stream_write;
+static MonoMethod* stream_seek;
+static MonoMethod* stream_get_length;
+static MonoMethod* stream_flush;
+
+static mono_embeddinator_once_t stream_once = MONO_EMBEDDINATOR_ONCE_INIT;
+
+static void stream_init()
+{
+    mono_embeddinator_lock_init(&stream_lock);
+
+    stream_class = mono_class_from_name(mono_get_corlib(), "System.IO", "Stream");
+    stream_read = mono_class_get_method_from_name(stream_class, "Read", 3);
+    stream_write = mono_class_get_method_from_name(stream_class, "Write", 3);
+    stream_seek = mono_class_get_method_from_name(stream_class, "Seek", 2);
+    stream_get_length = mono_class_get_method_from_name(stream_class, "get_Length", 0);
+    stream_flush = mono_class_get_method_from_name(stream_class, "Flush", 0);
+
+    unmanaged_memory_stream_class = mono_class_from_name(mono_get_corlib(), "System.IO",
+        "UnmanagedMemoryStream");
+    unmanaged_memory_stream_ctor = mono_embeddinator_lookup_method(
+        "System.IO.UnmanagedMemoryStream:.ctor(byte*,long,long,System.IO.FileAccess)",
+        unmanaged_memory_stream_class);
+}
+
+static stream_buffer_t stream_buffer_acquire()
+{
+    stream_buffer_t buffer;
+
+    mono_embeddinator_lock(&stream_lock);
+    bool pooled = stream_buffers_count > 0;
+    if (pooled)
+        buffer = stream_buffers[--stream_buffers_count];
+    else
+        stream_buffer_allocations++;
+    mono_embeddinator_unlock(&stream_lock);
+
+    if (pooled)
+        return buffer;
+
+    buffer.array = mono_array_new(mono_domain_get(), mono_get_byte_class(), STREAM_BUFFER_SIZE);
+    buffer.handle = mono_gchandle_new((MonoObject*) buffer.array, /*pinned=*/true);
+    buffer.data = mono_array_addr(buffer.array, char, 0);
+
+    return buffer;
+}
+
+static void stream_buffer_release(stream_buffer_t buffer)
+{
+    mono_embeddinator_lock(&stream_lock);
+    bool pooled = stream_buffers_count < STREAM_BUFFER_POOL_SIZE;
+    if (pooled)
+        stream_buffers[stream_buffers_count++] = buffer;
+    mono_embeddinator_unlock(&stream_lock);
+
+    if (!pooled)
+        mono_gchandle_free(buffer.handle);
+}
+
+MonoEmbedStream* mono_embeddinator_stream_new(MonoObject* object)
+{
+    if (!object)
+        return 0;
+
+    mono_embeddinator_once(&stream_once, stream_init);
+
+    // Resolve the overrides once so each call can be dispatched directly.
+    MonoEmbedStream* stream = g_new(MonoEmbedStream, 1);
+    stream->stream = mono_gchandle_new(object, /*pinned=*/false);
+    stream->read = (stream_read_fn) mono_method_get_unmanaged_thunk(
+        mono_object_get_virtual_method(object, stream_read));
+    stream->write = (stream_write_fn) mono_method_get_unmanaged_thunk(
+        mono_object_get_virtual_method(object, stream_write));
+    stream->seek = (stream_seek_fn) mono_method_get_unmanaged_thunk(
+        mono_object_get_virtual_method(object, stream_seek));
+    stream->get_length = (stream_get_length_fn) mono_method_get_unmanaged_thunk(
+        mono_object_get_virtual_method(object, stream_get_length));
+    stream->flush = (stream_flush_fn) mono_method_get_unmanaged_thunk(
+        mono_object_get_virtual_method(object, stream_flush));
+
+    return stream;
+}
+
+MonoEmbedStream* mono_embeddinator_stream_from_memory(void* data, int64_t length,
+    bool writable)
+{
+    mono_embeddinator_once(&stream_once, stream_init);
+
+    MonoObject* object = mono_object_new(mono_domain_get(), unmanaged_memory_stream_class);
+
+    /* System.IO.FileAccess */
+    int32_t access = writable ? 3 : 1;
+    void* args[4] = { &data, &length, &length, &access };
+
+    MonoObject* exception = 0;
+    mono_runtime_invoke(unmanaged_memory_stream_ctor, object, args, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        return 0;
+    }
+
+    return mono_embeddinator_stream_new(object);
+}
+
+MonoObject* mono_embeddinator_stream_get_object(MonoEmbedStream* stream)
+{
+    return stream ? mono_gchandle_get_target(stream->stream) : 0;
+}
+
+int32_t mono_embeddinator_stream_read(MonoEmbedStream* stream, void* buffer, int32_t count)
+{
+    MonoObject* object = mono_gchandle_get_target(stream->stream);
+    stream_buffer_t scratch = stream_buffer_acquire();
+
+    int32_t total = 0;
+    while (total < count)
+    {
+        int32_t size = count - total < STREAM_BUFFER_SIZE ? count - total : STREAM_BUFFER_SIZE;
+
+        MonoException* exception = 0;
+        int32_t read = stream->read(object, scratch.array, 0, size, &exception);
+        if (exception)
+        {
+            stream_buffer_release(scratch);
+            mono_embeddinator_throw_exception((MonoObject*) exception);
+            return -1;
+        }
+
+        memcpy((char*) buffer + total, scratch.data, read);
+        total += read;
+
+        // Return what is available instead of blocking for more data.
+        if (read < size)
+            break;
+    }
+
+    stream_buffer_release(scratch);
+    return total;
+}
+
+int32_t mono_embeddinator_stream_write(MonoEmbedStream* stream, const void* buffer,
+    int32_t count)
+{
+    MonoObject* object = mono_gchandle_get_target(stream->stream);
+    stream_buffer_t scratch = stream_buffer_acquire();
+
+    int32_t total = 0;
+    while (total < count)
+    {
+        int32_t size = count - total < STREAM_BUFFER_SIZE ? count - total : STREAM_BUFFER_SIZE;
+        memcpy(scratch.data, (const char*) buffer + total, size);
+
+        MonoException* exception = 0;
+        stream->write(object, scratch.array, 0, size, &exception);
+        if (exception)
+        {
+            stream_buffer_release(scratch);
+            mono_embeddinator_throw_exception((MonoObject*) exception);
+            return -1;
+        }
+
+        total += size;
+    }
+
+    stream_buffer_release(scratch);
+    return total;
+}
+
+int64_t mono_embeddinator_stream_seek(MonoEmbedStream* stream, int64_t offset, int32_t origin)
+{
+    MonoObject* object = mono_gchandle_get_target(stream->stream);
+
+    /* SEEK_SET, SEEK_CUR and SEEK_END match System.IO.SeekOrigin. */
+    MonoException* exception = 0;
+    int64_t position = stream->seek(object, offset, origin, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception((MonoObject*) exception);
+        return -1;
+    }
+
+    return position;
+}
+
+int64_t mono_embeddinator_stream_length(MonoEmbedStream* stream)
+{
+    MonoObject* object = mono_gchandle_get_target(stream->stream);
+
+    MonoException* exception = 0;
+    int64_t length = stream->get_length(object, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception((MonoObject*) exception);
+        return -1;
+    }
+
+    return length;
+}
+
+bool mono_embeddinator_stream_flush(MonoEmbedStream* stream)
+{
+    MonoObject* object = mono_gchandle_get_target(stream->stream);
+
+    MonoException* exception = 0;
+    stream->flush(object, &exception);
+    if (exception)
+    {
+        mono_embeddinator_throw_exception((MonoObject*) exception);
+        return false;
+    }
+
+    return true;
+}
+
+void mono_embeddinator_stream_destroy(MonoEmbedStream* stream)
+{
+    if (!stream)
+        return;
+
+    mono_gchandle_free(stream->stream);
+    g_free(stream);
+}
+
+/**
+ * Invokers
+ *
+ * Descriptors are resolved the same way as the lookups of the expanded
+ * functions: concurrent first calls may both look the method up, and store
+ * the same value.
+ */
+static MonoMethod* invoke_resolve(mono_embeddinator_method_desc_t* desc)
+{
+    if (!desc->method)
+    {
+        desc->lookup_class();
+        desc->method = mono_embeddinator_lookup_method(desc->method_name, *desc->klass);
+    }
+
+    return desc->method;
+}
+
+static void* invoke_marshal_arg(MonoDomain* domain, uint8_t kind, void* arg)
+{
+    switch (kind)
+    {
+    case MONO_EMBEDDINATOR_KIND_STRING:
+    {
+        const char* str = *(const char**)arg;
+        return str ? mono_string_new(domain, str) : 0;
+    }
+    case MONO_EMBEDDINATOR_KIND_CACHED_STRING:
+    {
+        const char* str = *(const char**)arg;
+        return str ? mono_embeddinator_string_cache_lookup(domain, str) : 0;
+    }
+    case MONO_EMBEDDINATOR_KIND_OBJECT:
+    {
+        MonoEmbedObject* object = *(MonoEmbedObject**)arg;
+        return object ? mono_gchandle_get_target(object->_handle) : 0;
+    }
+    case MONO_EMBEDDINATOR_KIND_STRUCT:
+    {
+        MonoEmbedObject* object = *(MonoEmbedObject**)arg;
+        return object ? mono_object_unbox(mono_gchandle_get_target(object->_handle)) : 0;
+    }
+    default:
+        return arg;
+    }
+}
+
+void mono_embeddinator_invoke(mono_embeddinator_method_desc_t* desc, void* instance,
+    void** args, void* result)
+{
+    MonoMethod* method = invoke_resolve(desc);
+    MonoDomain* domain = mono_domain_get();
+
+    void* margs[MONO_EMBEDDINATOR_INVOKE_MAX_PARAMS];
+    for (int i = 0; i < desc->param_count; i++)
+        margs[i] = invoke_marshal_arg(domain, desc->param_kinds[i], args[i]);
+
+    MonoObject* object = 0;
+    if (desc->flags & MONO_EMBEDDINATOR_INVOKE_CONSTRUCTOR)
+    {
+        object = mono_object_new(domain, *desc->klass);
+    }
+    else if (desc->flags & MONO_EMBEDDINATOR_INVOKE_INSTANCE)
+    {
+        object = mono_gchandle_get_target(((MonoEmbedObject*)instance)->_handle);
+        if (desc->flags & MONO_EMBEDDINATOR_INVOKE_VIRTUAL)
+            method = mono_object_get_virtual_method(object, method);
+    }
+
+    void* target = (object && (desc->flags & MONO_EMBEDDINATOR_INVOKE_VALUE_TYPE)) ?
+        mono_object_unbox(object) : object;
+
+    MonoObject* exception = 0;
+    MonoObject* ret = mono_runtime_invoke(method, target, margs,
+        (desc->flags & MONO_EMBEDDINATOR_INVOKE_NO_THROW) ? 0 : &exception);
+
+    if (desc->flags & MONO_EMBEDDINATOR_INVOKE_CONSTRUCTOR)
+        ret = object;
+
+    if (exception)
+    {
+        mono_embeddinator_throw_exception(exception);
+        ret = 0;
+    }
+
+    switch (desc->return_kind)
+    {
+    case MONO_EMBEDDINATOR_KIND_VOID:
+        break;
+    case MONO_EMBEDDINATOR_KIND_VALUE:
+        if (ret)
+            memcpy(result, mono_object_unbox(ret), desc->return_size);
+        else
+            memset(result, 0, desc->return_size);
+        break;
+    case MONO_EMBEDDINATOR_KIND_STRING:
+    case MONO_EMBEDDINATOR_KIND_CACHED_STRING:
+        *(char**)result = ret ? mono_string_to_utf8((MonoString*)ret) : 0;
+        break;
+    default:
+        *(void**)result = ret ? mono_embeddinator_create_object(ret) : 0;
+        break;
+    }
+}
+
+/**
+ * Dynamic invocation
+ *
+ * Tables are only added when libraries are loaded and never removed, so
+ * lookups walk the list without taking the lock. The head of the list is
+ * published with release semantics and read with acquire semantics, so a
+ * lookup seeing a table also sees its contents.
+ */
+static mono_embeddinator_lock_t dynamic_lock;
+static mono_embeddinator_once_t dynamic_once = MONO_EMBEDDINATOR_ONCE_INIT;
+static mono_embeddinator_dynamic_table_t* dynamic_tables;
+
+static mono_embeddinator_dynamic_table_t* dynamic_tables_load()
+{
+#ifdef _WIN32
+    return (mono_embeddinator_dynamic_table_t*) InterlockedCompareExchangePointer(
+        (PVOID volatile*) &dynamic_tables, NULL, NULL);
+#else
+    return __atomic_load_n(&dynamic_tables, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void dynamic_tables_store(mono_embeddinator_dynamic_table_t* table)
+{
+#ifdef _WIN32
+    InterlockedExchangePointer((PVOID volatile*) &dynamic_tables, table);
+#else
+    __atomic_store_n(&dynamic_tables, table, __ATOMIC_RELEASE);
+#endif
+}
+
+static void dynamic_init()
+{
+    mono_embeddinator_lock_init(&dynamic_lock);
+}
+
+// FNV-1a, starting from the seed instead of the offset basis when it is not 0.
+// Must match PerfectHashTable.Hash in the generator.
+static uint32_t dynamic_hash(uint32_t seed, const char* name)
+{
+    uint32_t hash = seed ? seed : 0x811c9dc5;
+    for (; *name; name++)
+        hash = (hash ^ (uint8_t)*name) * 0x01000193;
+    return hash;
+}
+
+void mono_embeddinator_register_dynamic_table(mono_embeddinator_dynamic_table_t* table)
+{
+    mono_embeddinator_once(&dynamic_once, dynamic_init);
+    mono_embeddinator_lock(&dynamic_lock);
+
+    table->next = dynamic_tables;
+    dynamic_tables_store(table);
+
+    mono_embeddinator_unlock(&dynamic_lock);
+}
+
+const mono_embeddinator_dynamic_entry_t* mono_embeddinator_lookup_dynamic(const char* name)
+{
+    uint32_t hash = dynamic_hash(0, name);
+
+    for (mono_embeddinator_dynamic_table_t* table = dynamic_tables_load(); table; table = table->next)
+    {
+        int32_t displacement = table->displacements[hash % table->count];
+        uint32_t slot = displacement < 0 ? (uint32_t)(-displacement - 1) :
+            dynamic_hash((uint32_t)displacement, name) % table->count;
+
+        const mono_embeddinator_dynamic_entry_t* entry = &table->entries[slot];
+        if (strcmp(entry->name, name) == 0)
+            return entry;
+    }
+
+    return 0;
+}
+
+void mono_embeddinator_invoke_entry(const mono_embeddinator_dynamic_entry_t* entry,
+    void** args, void* result)
+{
+    void* instance = 0;
+    if (entry->desc->flags & MONO_EMBEDDINATOR_INVOKE_INSTANCE)
+        instance = *(void**)*args++;
+
+    mono_embeddinator_invoke(entry->desc, instance, args, result);
+}
+
+bool mono_embeddinator_invoke_dynamic(const char* name, void** args, void* result)
+{
+    const mono_embeddinator_dynamic_entry_t* entry = mono_embeddinator_lookup_dynamic(name);
+    if (!entry)
+        return false;
+
+    mono_embeddinator_invoke_entry(entry, args, result);
+    return true;
+}
+
+/**
+ * Statistics
+ */
+void mono_embeddinator_get_stats(mono_embeddinator_stats_t* stats)
+{
+    memset(stats, 0, sizeof(mono_embeddinator_stats_t));
+
+    for (int i = 0; i < STRING_CACHE_SETS; i++)
+    {
+        mono_embeddinator_lock_t* lock = string_cache_set_lock(i);
+        mono_embeddinator_lock(lock);
+
+        stats->string_cache_hits += string_cache[i].hits;
+        stats->string_cache_misses += string_cache[i].misses;
+        stats->string_cache_evictions += string_cache[i].evictions;
+
+        mono_embeddinator_unlock(lock);
+    }
+
+    stats->stream_buffer_allocations = stream_buffer_allocations;
+    stats->lent_array_reuses = lent_array_reuses;
+}
+
+void mono_embeddinator_reset_stats()
+{
+    for (int i = 0; i < STRING_CACHE_SETS; i++)
+    {
+        mono_embeddinator_lock_t* lock = string_cache_set_lock(i);
+        mono_embeddinator_lock(lock);
+
+        string_cache[i].hits = 0;
+        string_cache[i].misses = 0;
+        string_cache[i].evictions = 0;
+
+        mono_embeddinator_unlock(lock);
+    }
+
+    stream_buffer_allocations = 0;
+    lent_array_reuses = 0;
+}
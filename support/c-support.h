@@ -55,6 +55,20 @@ typedef MonoEmbedArray _DoubleArray;
 typedef MonoEmbedArray _StringArray;
 typedef MonoEmbedArray _DecimalArray;
 
+/**
+ * Releases a string returned by the C API, for bindings that cannot
+ * call mono_free directly.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_string_free(char* string);
+
+/**
+ * Releases an array returned by the C API, for bindings that cannot
+ * call g_array_free directly.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_array_free(MonoEmbedArray array);
+
 /**
  * Performs marshaling of a given MonoDecimal to a GLib string.
  */
@@ -73,4 +87,480 @@ MonoDecimal mono_embeddinator_string_to_decimal (const char * number);
 MONO_EMBEDDINATOR_API
 void mono_embeddinator_marshal_string_to_gstring(GString* g_string, MonoString* mono_string);
 
+/**
+ * One-time initialization
+ *
+ * Used by the generated code for the lookups shared by all the calls of a
+ * function. Callers racing the first call wait for the initialization to be
+ * done, later calls only read the flag.
+ */
+typedef int32_t mono_embeddinator_init_flag_t;
+
+/**
+ * Calls the given function unless the given flag says it was already called.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_init_once(volatile mono_embeddinator_init_flag_t* flag, void (*init)());
+
+/**
+ * String cache
+ *
+ * Bounded, set-associative cache of managed strings keyed by their native
+ * UTF-8 contents. Used by the generated code for string parameters marked with
+ * [Embeddinator.CacheableString] so hot, repeated arguments (keys, identifiers)
+ * do not allocate a new managed string on every call.
+ */
+
+/**
+ * Returns a managed string for the given native string, reusing a previously
+ * created one when the same contents were recently marshaled.
+ * Strings longer than the cacheable length bypass the cache.
+ */
+MONO_EMBEDDINATOR_API
+MonoString* mono_embeddinator_string_cache_lookup(MonoDomain* domain, const char* str);
+
+/**
+ * Releases all the managed strings held by the string cache.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_string_cache_clear();
+
+/**
+ * Lent arrays
+ *
+ * Per-thread managed arrays reused across calls by the generated code for array
+ * parameters marked with [Embeddinator.DoesNotRetainArguments], so passing them
+ * does not allocate a new managed array on every call. The arrays are only held
+ * through weak handles, so they can still be collected when not in use.
+ */
+
+/**
+ * Returns a managed array with the given element class and length for the
+ * parameter in the given slot, reusing the array lent to the previous call
+ * when it is still alive. Nested calls using the same slot get a new array.
+ */
+MONO_EMBEDDINATOR_API
+MonoArray* mono_embeddinator_array_lend(MonoDomain* domain, MonoClass* element_class,
+    uintptr_t length, int slot);
+
+/**
+ * Gives back the array lent for the given slot once the call returned.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_array_return(int slot);
+
+/**
+ * String views
+ *
+ * Read-only view over the UTF-16 characters of a managed string, returned by
+ * the _view variant of the functions returning a string. The string is pinned
+ * until the view is released, so its characters are read in place without
+ * being copied or transcoded. The characters are not null-terminated.
+ */
+typedef struct MonoEmbedStringView
+{
+    const uint16_t* chars;
+    int32_t len;
+    uint32_t handle;
+} MonoEmbedStringView;
+
+/**
+ * Pins a managed string and returns a view over its characters. A null
+ * string gives a view with null characters.
+ */
+MONO_EMBEDDINATOR_API
+MonoEmbedStringView mono_embeddinator_string_view_new(MonoString* mono_string);
+
+/**
+ * Unpins the string of a view, after which its characters cannot be accessed.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_string_view_release(MonoEmbedStringView* view);
+
+/**
+ * Iterators
+ *
+ * Native iterator over a managed IEnumerable<T>, IList<T> or IReadOnlyList<T>
+ * returned by the generated code. Elements are pulled in chunks into a native
+ * buffer: primitive and enum elements are copied as a contiguous array of the
+ * element type, strings as UTF-8 pointers valid until the next call and bound
+ * objects as newly created object handles.
+ *
+ * Sequences are fully enumerated when the iterator is created, so they must
+ * be finite and their exceptions are reported by mono_embeddinator_iterator_new.
+ */
+typedef struct MonoEmbedIterator MonoEmbedIterator;
+
+typedef enum
+{
+    MONO_EMBEDDINATOR_ITERATOR_VALUE = 0,
+    MONO_EMBEDDINATOR_ITERATOR_STRING,
+    MONO_EMBEDDINATOR_ITERATOR_OBJECT
+} mono_embeddinator_iterator_kind_t;
+
+/**
+ * Creates an iterator over the given managed collection.
+ * Returns NULL if the collection is NULL or a managed exception was thrown.
+ */
+MONO_EMBEDDINATOR_API
+MonoEmbedIterator* mono_embeddinator_iterator_new(MonoObject* collection,
+    MonoClass* element_class, mono_embeddinator_iterator_kind_t kind);
+
+/**
+ * Copies up to capacity elements into the given buffer.
+ * Returns the number of elements copied, 0 when the iteration is done.
+ */
+MONO_EMBEDDINATOR_API
+int32_t mono_embeddinator_iterator_next(MonoEmbedIterator* iterator, void* buffer,
+    int32_t capacity);
+
+/**
+ * Returns the number of elements of the collection.
+ */
+MONO_EMBEDDINATOR_API
+int32_t mono_embeddinator_iterator_count(MonoEmbedIterator* iterator);
+
+/**
+ * Destroys the iterator and releases the managed objects it references.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_iterator_destroy(MonoEmbedIterator* iterator);
+
+/**
+ * Futures
+ *
+ * Native handle to a managed Task or Task<T> returned by the generated code.
+ * The managed operation keeps running on the managed thread pool while the
+ * native caller polls or waits for it, so a single native thread can keep
+ * many operations in flight.
+ */
+typedef struct MonoEmbedFuture MonoEmbedFuture;
+
+typedef enum
+{
+    MONO_EMBEDDINATOR_FUTURE_PENDING = 0,
+    MONO_EMBEDDINATOR_FUTURE_COMPLETED,
+    MONO_EMBEDDINATOR_FUTURE_FAULTED,
+    MONO_EMBEDDINATOR_FUTURE_CANCELED
+} mono_embeddinator_future_status_t;
+
+/**
+ * Creates a future for the given managed task, bound as a Task<T> when
+ * has_result is set and as a Task otherwise.
+ * Returns NULL if the task is NULL.
+ */
+MONO_EMBEDDINATOR_API
+MonoEmbedFuture* mono_embeddinator_future_new(MonoObject* task, bool has_result);
+
+/**
+ * Returns the current status of the future without blocking.
+ * If the status cannot be read, the exception is reported and
+ * MONO_EMBEDDINATOR_FUTURE_FAULTED is returned.
+ */
+MONO_EMBEDDINATOR_API
+mono_embeddinator_future_status_t mono_embeddinator_future_status(MonoEmbedFuture* future);
+
+/**
+ * Returns whether the future has completed, either successfully or not.
+ */
+MONO_EMBEDDINATOR_API
+bool mono_embeddinator_future_is_completed(MonoEmbedFuture* future);
+
+/**
+ * Blocks for up to timeout milliseconds (-1 waits forever) until the future
+ * completes. Returns whether the future has completed.
+ */
+MONO_EMBEDDINATOR_API
+bool mono_embeddinator_future_wait(MonoEmbedFuture* future, int32_t timeout);
+
+/**
+ * Blocks for up to timeout milliseconds (-1 waits forever) until any of the
+ * given futures completes. Returns the index of a completed future, or -1 if
+ * the timeout elapsed.
+ */
+MONO_EMBEDDINATOR_API
+int32_t mono_embeddinator_future_wait_any(MonoEmbedFuture** futures, int32_t count,
+    int32_t timeout);
+
+/**
+ * Waits for the future and returns the managed result of a Task<T>, or NULL for
+ * a Task. A fault or cancellation is reported as the exception that caused it,
+ * and NULL is returned.
+ */
+MONO_EMBEDDINATOR_API
+MonoObject* mono_embeddinator_future_get_result(MonoEmbedFuture* future);
+
+/**
+ * Destroys the future. The managed operation is not canceled.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_future_destroy(MonoEmbedFuture* future);
+
+/**
+ * Callbacks
+ *
+ * Native function pointers bound as managed delegates. The generated code keeps
+ * a fixed pool of native trampolines per delegate type, each slot forwarding to
+ * a native function and its context pointer. The managed delegate wrapping each
+ * trampoline is created once and reused, so invoking it from managed code costs
+ * a native call plus one indirect call.
+ */
+#if defined(_WIN32) && !defined(_WIN64)
+#define MONO_EMBEDDINATOR_CALLBACK __stdcall
+#else
+#define MONO_EMBEDDINATOR_CALLBACK
+#endif
+
+typedef struct
+{
+    void* fn;
+    void* context;
+    // Strong handle to the delegate while referenced, weak handle afterwards.
+    uint32_t delegate;
+    int32_t references;
+} mono_embeddinator_callback_slot_t;
+
+typedef struct
+{
+    mono_embeddinator_callback_slot_t* slots;
+    void** trampolines;
+    int32_t count;
+} mono_embeddinator_callback_pool_t;
+
+/**
+ * Returns a managed delegate of the given type forwarding to the native function
+ * and context, reusing the slot already bound to them if any.
+ * Returns NULL if all the slots of the pool are bound to delegates managed code
+ * can still reach.
+ */
+MONO_EMBEDDINATOR_API
+MonoObject* mono_embeddinator_callback_acquire(mono_embeddinator_callback_pool_t* pool,
+    MonoClass* delegate_class, void* fn, void* context);
+
+/**
+ * Releases a delegate returned by mono_embeddinator_callback_acquire. Once all
+ * the references to it were released, its slot is bound to another function
+ * only after the delegate was collected, so managed code still holding it keeps
+ * calling the function it was created for.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_callback_release(mono_embeddinator_callback_pool_t* pool,
+    MonoObject* delegate);
+
+/**
+ * Streams
+ *
+ * Native handle to a managed System.IO.Stream. Data is transferred through a
+ * pool of pinned, reusable managed byte buffers, so reads and writes do not
+ * allocate once the pool is warm.
+ */
+typedef struct MonoEmbedStream MonoEmbedStream;
+
+/**
+ * Creates a native handle for the given managed stream.
+ * Returns NULL if the stream is NULL.
+ */
+MONO_EMBEDDINATOR_API
+MonoEmbedStream* mono_embeddinator_stream_new(MonoObject* stream);
+
+/**
+ * Creates a managed stream reading (and writing, if writable) the given native
+ * memory in place. The memory must outlive the stream.
+ */
+MONO_EMBEDDINATOR_API
+MonoEmbedStream* mono_embeddinator_stream_from_memory(void* data, int64_t length,
+    bool writable);
+
+/**
+ * Returns the managed stream of the given handle.
+ */
+MONO_EMBEDDINATOR_API
+MonoObject* mono_embeddinator_stream_get_object(MonoEmbedStream* stream);
+
+/**
+ * Reads up to count bytes into the given buffer.
+ * Returns the number of bytes read, 0 at the end of the stream or -1 if a
+ * managed exception was thrown.
+ */
+MONO_EMBEDDINATOR_API
+int32_t mono_embeddinator_stream_read(MonoEmbedStream* stream, void* buffer, int32_t count);
+
+/**
+ * Writes count bytes from the given buffer.
+ * Returns the number of bytes written or -1 if a managed exception was thrown.
+ */
+MONO_EMBEDDINATOR_API
+int32_t mono_embeddinator_stream_write(MonoEmbedStream* stream, const void* buffer,
+    int32_t count);
+
+/**
+ * Sets the position of the stream, origin takes the SEEK_SET, SEEK_CUR and
+ * SEEK_END values. Returns the new position or -1 on failure.
+ */
+MONO_EMBEDDINATOR_API
+int64_t mono_embeddinator_stream_seek(MonoEmbedStream* stream, int64_t offset, int32_t origin);
+
+/**
+ * Returns the length of the stream or -1 on failure.
+ */
+MONO_EMBEDDINATOR_API
+int64_t mono_embeddinator_stream_length(MonoEmbedStream* stream);
+
+/**
+ * Flushes the stream. Returns false if a managed exception was thrown.
+ */
+MONO_EMBEDDINATOR_API
+bool mono_embeddinator_stream_flush(MonoEmbedStream* stream);
+
+/**
+ * Destroys the native handle. The managed stream is not closed.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_stream_destroy(MonoEmbedStream* stream);
+
+/**
+ * Invokers
+ *
+ * Table-driven calls used by the functions generated with --compact-invokers.
+ * Each generated function only passes the address of its arguments and the
+ * descriptor of its method to a shared invoker, which marshals them following
+ * the kinds recorded in the descriptor.
+ */
+#define MONO_EMBEDDINATOR_INVOKE_MAX_PARAMS 16
+
+typedef enum
+{
+    // No value, only valid for results.
+    MONO_EMBEDDINATOR_KIND_VOID = 0,
+    // Primitive or enum value, passed as is.
+    MONO_EMBEDDINATOR_KIND_VALUE,
+    // UTF-8 string.
+    MONO_EMBEDDINATOR_KIND_STRING,
+    // UTF-8 string looked up in the string cache.
+    MONO_EMBEDDINATOR_KIND_CACHED_STRING,
+    // Bound object of a reference type.
+    MONO_EMBEDDINATOR_KIND_OBJECT,
+    // Bound object of a value type, passed unboxed.
+    MONO_EMBEDDINATOR_KIND_STRUCT
+} mono_embeddinator_kind_t;
+
+typedef enum
+{
+    MONO_EMBEDDINATOR_INVOKE_INSTANCE = 1 << 0,
+    MONO_EMBEDDINATOR_INVOKE_VIRTUAL = 1 << 1,
+    MONO_EMBEDDINATOR_INVOKE_VALUE_TYPE = 1 << 2,
+    MONO_EMBEDDINATOR_INVOKE_NO_THROW = 1 << 3,
+    MONO_EMBEDDINATOR_INVOKE_CONSTRUCTOR = 1 << 4
+} mono_embeddinator_invoke_flags_t;
+
+typedef struct
+{
+    // Resolved on the first call.
+    MonoMethod* method;
+    // Kind of each parameter, as mono_embeddinator_kind_t values.
+    const uint8_t* param_kinds;
+    uint8_t param_count;
+    uint8_t return_kind;
+    uint8_t return_size;
+    uint8_t flags;
+    const char* method_name;
+    MonoClass** klass;
+    // Looks up the class into *klass, initializing the runtime if needed.
+    void (*lookup_class)();
+} mono_embeddinator_method_desc_t;
+
+/**
+ * Calls the method of the given descriptor. Each element of args points to the
+ * native value of a parameter, and the native result is stored into result.
+ * The instance is the bound object the method is called on, or NULL for static
+ * methods and constructors, which store the new bound object into result.
+ * If a managed exception is thrown, it is reported and the result is zeroed.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_invoke(mono_embeddinator_method_desc_t* desc, void* instance,
+    void** args, void* result);
+
+/**
+ * Dynamic invocation
+ *
+ * Bound functions looked up by name at runtime, for hosts that only know which
+ * functions to call once running. The functions generated with --dynamic-invoke
+ * are kept in a minimal perfect hash table per assembly, which is registered
+ * when the library is loaded, so a lookup hashes the name twice per assembly
+ * and compares it once.
+ */
+typedef struct
+{
+    // Name of the C function.
+    const char* name;
+    void (*function)();
+    mono_embeddinator_method_desc_t* desc;
+} mono_embeddinator_dynamic_entry_t;
+
+typedef struct mono_embeddinator_dynamic_table_t
+{
+    // Entries by slot.
+    const mono_embeddinator_dynamic_entry_t* entries;
+    // Displacement of each bucket: the seed hashing its names to their slots,
+    // or -slot - 1 for buckets holding a single name.
+    const int32_t* displacements;
+    uint32_t count;
+    struct mono_embeddinator_dynamic_table_t* next;
+} mono_embeddinator_dynamic_table_t;
+
+/**
+ * Registers the table of an assembly. Called by the generated code when the
+ * library is loaded.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_register_dynamic_table(mono_embeddinator_dynamic_table_t* table);
+
+/**
+ * Returns the entry of the bound function with the given name, or NULL if no
+ * registered table has it. Entries stay valid while the library is loaded, so
+ * they can be looked up once and invoked many times.
+ */
+MONO_EMBEDDINATOR_API
+const mono_embeddinator_dynamic_entry_t* mono_embeddinator_lookup_dynamic(const char* name);
+
+/**
+ * Calls the bound function of an entry. Each element of args points to the
+ * value of a parameter of the C function, starting with the object for
+ * instance methods, and its return value is stored into result.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_invoke_entry(const mono_embeddinator_dynamic_entry_t* entry,
+    void** args, void* result);
+
+/**
+ * Looks up and calls the bound function with the given name, see
+ * mono_embeddinator_invoke_entry. Returns false if no function has this name.
+ */
+MONO_EMBEDDINATOR_API
+bool mono_embeddinator_invoke_dynamic(const char* name, void** args, void* result);
+
+/**
+ * Statistics
+ */
+typedef struct
+{
+    uint64_t string_cache_hits;
+    uint64_t string_cache_misses;
+    uint64_t string_cache_evictions;
+    uint64_t stream_buffer_allocations;
+    uint64_t lent_array_reuses;
+} mono_embeddinator_stats_t;
+
+/**
+ * Fills the given structure with the current support runtime statistics.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_get_stats(mono_embeddinator_stats_t* stats);
+
+/**
+ * Resets the support runtime statistics.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_reset_stats();
+
 MONO_EMBEDDINATOR_END_DECLS
\ No newline at end of file
@@ -0,0 +1,416 @@
+/*
+ * C++ support code
+ *
+ * Copyright (C) 2017 Microsoft Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "The generated C++ bindings require C++17 or later."
+#endif
+
+#include "c-support.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace mono_embeddinator
+{
+
+/**
+ * Tag used to take ownership of an object handle returned by the C API.
+ */
+struct adopt_t
+{
+    explicit adopt_t() = default;
+};
+
+inline constexpr adopt_t adopt{};
+
+/**
+ * Owns the MonoEmbedObject of a managed object and releases its GC handle
+ * on destruction. Objects are move-only: moving transfers the handle without
+ * calling into the runtime.
+ */
+class object
+{
+public:
+    object(object&& other) noexcept
+        : _handle(other._handle)
+    {
+        other._handle = nullptr;
+    }
+
+    object& operator=(object&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _handle = other._handle;
+            other._handle = nullptr;
+        }
+        return *this;
+    }
+
+    object(const object&) = delete;
+    object& operator=(const object&) = delete;
+
+    ~object()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _handle != nullptr;
+    }
+
+    /**
+     * Gives up ownership of the handle, which must then be released with
+     * mono_embeddinator_destroy_object.
+     */
+    MonoEmbedObject* release() noexcept
+    {
+        MonoEmbedObject* handle = _handle;
+        _handle = nullptr;
+        return handle;
+    }
+
+    void reset() noexcept
+    {
+        if (_handle)
+        {
+            mono_embeddinator_destroy_object(_handle);
+            _handle = nullptr;
+        }
+    }
+
+    friend MonoEmbedObject* get_handle(const object& value) noexcept;
+
+protected:
+    object(std::nullptr_t) noexcept
+        : _handle(nullptr)
+    {
+    }
+
+    object(adopt_t, void* handle) noexcept
+        : _handle(static_cast<MonoEmbedObject*>(handle))
+    {
+    }
+
+    MonoEmbedObject* _handle;
+};
+
+/**
+ * Gets the handle of an object without giving up its ownership.
+ */
+inline MonoEmbedObject* get_handle(const object& value) noexcept
+{
+    return value._handle;
+}
+
+/**
+ * Owns a string returned by the C API. The UTF-8 data is exposed as is
+ * and released with mono_free on destruction, without copying it.
+ */
+class owned_string
+{
+public:
+    owned_string() noexcept
+        : _data(nullptr)
+    {
+    }
+
+    explicit owned_string(const char* data) noexcept
+        : _data(const_cast<char*>(data))
+    {
+    }
+
+    owned_string(owned_string&& other) noexcept
+        : _data(other._data)
+    {
+        other._data = nullptr;
+    }
+
+    owned_string& operator=(owned_string&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (_data)
+                mono_free(_data);
+            _data = other._data;
+            other._data = nullptr;
+        }
+        return *this;
+    }
+
+    owned_string(const owned_string&) = delete;
+    owned_string& operator=(const owned_string&) = delete;
+
+    ~owned_string()
+    {
+        if (_data)
+            mono_free(_data);
+    }
+
+    /** Null if the managed string was null. */
+    const char* c_str() const noexcept
+    {
+        return _data;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return _data ? std::string_view(_data) : std::string_view();
+    }
+
+    operator std::string_view() const noexcept
+    {
+        return view();
+    }
+
+    std::string str() const
+    {
+        return std::string(view());
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _data != nullptr;
+    }
+
+private:
+    char* _data;
+};
+
+/**
+ * Null-terminated string argument. Null-terminated inputs are passed through
+ * as is, and string views are only copied to a small inline buffer unless
+ * they do not fit in it.
+ */
+class string_ref
+{
+public:
+    string_ref(const char* data) noexcept
+        : _data(data)
+    {
+    }
+
+    string_ref(const std::string& data) noexcept
+        : _data(data.c_str())
+    {
+    }
+
+    string_ref(std::string_view data)
+    {
+        if (data.size() < sizeof(_buffer))
+        {
+            std::memcpy(_buffer, data.data(), data.size());
+            _buffer[data.size()] = '\0';
+            _data = _buffer;
+        }
+        else
+        {
+            _storage.assign(data.data(), data.size());
+            _data = _storage.c_str();
+        }
+    }
+
+    string_ref(const string_ref&) = delete;
+    string_ref& operator=(const string_ref&) = delete;
+
+    const char* c_str() const noexcept
+    {
+        return _data;
+    }
+
+private:
+    const char* _data;
+    char _buffer[128];
+    std::string _storage;
+};
+
+#if defined(__cpp_lib_span)
+
+template <typename T>
+using span = std::span<T>;
+
+#else
+
+/**
+ * Minimal stand-in for std::span when compiling against C++17.
+ */
+template <typename T>
+class span
+{
+public:
+    span() noexcept
+        : _data(nullptr), _size(0)
+    {
+    }
+
+    span(T* data, size_t size) noexcept
+        : _data(data), _size(size)
+    {
+    }
+
+    template <size_t N>
+    span(T (&data)[N]) noexcept
+        : _data(data), _size(N)
+    {
+    }
+
+    template <typename U, size_t N,
+        typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    span(const std::array<U, N>& data) noexcept
+        : _data(data.data()), _size(N)
+    {
+    }
+
+    template <typename U, typename A,
+        typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    span(const std::vector<U, A>& data) noexcept
+        : _data(data.data()), _size(data.size())
+    {
+    }
+
+    T* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    T* begin() const noexcept { return _data; }
+    T* end() const noexcept { return _data + _size; }
+    T& operator[](size_t index) const noexcept { return _data[index]; }
+
+private:
+    T* _data;
+    size_t _size;
+};
+
+#endif
+
+/**
+ * Describes a span of values as an array parameter of the C API without
+ * copying it. Only valid for the duration of the call it is passed to.
+ */
+template <typename T>
+class array_arg
+{
+public:
+    explicit array_arg(span<const T> values) noexcept
+    {
+        _header.data = reinterpret_cast<gchar*>(const_cast<T*>(values.data()));
+        _header.len = static_cast<gint>(values.size());
+        _array.array = &_header;
+    }
+
+    array_arg(const array_arg&) = delete;
+    array_arg& operator=(const array_arg&) = delete;
+
+    operator MonoEmbedArray() const noexcept
+    {
+        return _array;
+    }
+
+private:
+    GArray _header;
+    MonoEmbedArray _array;
+};
+
+/**
+ * Owns an array returned by the C API, exposing its elements in place.
+ */
+template <typename T>
+class array
+{
+public:
+    array() noexcept
+    {
+        _array.array = nullptr;
+    }
+
+    explicit array(MonoEmbedArray native) noexcept
+        : _array(native)
+    {
+    }
+
+    array(array&& other) noexcept
+        : _array(other._array)
+    {
+        other._array.array = nullptr;
+    }
+
+    array& operator=(array&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (_array.array)
+                g_array_free(_array.array, true);
+            _array = other._array;
+            other._array.array = nullptr;
+        }
+        return *this;
+    }
+
+    array(const array&) = delete;
+    array& operator=(const array&) = delete;
+
+    ~array()
+    {
+        if (_array.array)
+            g_array_free(_array.array, true);
+    }
+
+    const T* data() const noexcept
+    {
+        return _array.array ? reinterpret_cast<const T*>(_array.array->data) : nullptr;
+    }
+
+    size_t size() const noexcept
+    {
+        return _array.array ? static_cast<size_t>(_array.array->len) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + size(); }
+    const T& operator[](size_t index) const noexcept { return data()[index]; }
+
+    operator span<const T>() const noexcept
+    {
+        return span<const T>(data(), size());
+    }
+
+private:
+    MonoEmbedArray _array;
+};
+
+} // namespace mono_embeddinator
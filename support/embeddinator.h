@@ -57,6 +57,33 @@
     #define MONO_EMBEDDINATOR_API MONO_EMBEDDINATOR_API_IMPORT
 #endif
 
+#ifdef _WIN32
+    #define MONO_EMBEDDINATOR_THREAD_LOCAL __declspec(thread)
+#else
+    #define MONO_EMBEDDINATOR_THREAD_LOCAL __thread
+#endif
+
+/**
+ * Defines a function run when the library is loaded. The name of the function
+ * must be unique across the library.
+ */
+#ifdef _MSC_VER
+    #pragma section(".CRT$XCU", read)
+    #ifdef _WIN64
+        #define MONO_EMBEDDINATOR_CONSTRUCTOR_SYMBOL_PREFIX ""
+    #else
+        #define MONO_EMBEDDINATOR_CONSTRUCTOR_SYMBOL_PREFIX "_"
+    #endif
+    #define MONO_EMBEDDINATOR_CONSTRUCTOR(fn) \
+        static void fn(void); \
+        __declspec(allocate(".CRT$XCU")) void (*fn##_init)(void) = fn; \
+        __pragma(comment(linker, "/include:" MONO_EMBEDDINATOR_CONSTRUCTOR_SYMBOL_PREFIX #fn "_init")) \
+        static void fn(void)
+#else
+    #define MONO_EMBEDDINATOR_CONSTRUCTOR(fn) \
+        __attribute__((constructor)) static void fn(void)
+#endif
+
 /**
  * Objects
  */
@@ -35,6 +35,15 @@
 
 G_BEGIN_DECLS
 
+/*
+ * The bindings return strings and arrays allocated by these functions, which
+ * their users free with them, so they stay exported from libraries built with
+ * -fvisibility=hidden.
+ */
+#if defined(__GNUC__)
+#pragma GCC visibility push(default)
+#endif
+
 /*
  * Basic data types
  */
@@ -243,6 +252,10 @@ gboolean g_path_is_absolute    (const char *filename);
  
 #define GLIB_CHECK_VERSION(a,b,c) ((a < _EGLIB_MAJOR) || (a == _EGLIB_MAJOR && (b < _EGLIB_MIDDLE || (b == _EGLIB_MIDDLE && c <= _EGLIB_MINOR))))
  
+#if defined(__GNUC__)
+#pragma GCC visibility pop
+#endif
+
 G_END_DECLS
 
 #endif
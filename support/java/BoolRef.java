@@ -1,10 +1,7 @@
 /*
  * Mono Embeddinator-4000 Java support code.
  *
- * Author:
- *   Joao Matos (joao.matos@xamarin.com)
- *
- * (C) 2016 Microsoft, Inc.
+ * (C) 2017 Microsoft, Inc.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -28,14 +25,15 @@
 
 package mono.embeddinator;
 
-import com.sun.jna.*;
-
-public class UnsignedInt extends IntegerType {
-    public UnsignedInt() {
-         super(4, true);
+/**
+ * Holder for bool ref parameters, which is also accepted by out
+ * parameters of the same type.
+ */
+public class BoolRef extends BoolOut {
+    public BoolRef() {
     }
 
-    public UnsignedInt(long value) {
-         super(4, value, true);
+    public BoolRef(boolean value) {
+        set(value);
     }
 }
@@ -1,10 +1,7 @@
 /*
  * Mono Embeddinator-4000 Java support code.
  *
- * Author:
- *   Joao Matos (joao.matos@xamarin.com)
- *
- * (C) 2016 Microsoft, Inc.
+ * (C) 2017 Microsoft, Inc.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -28,15 +25,15 @@
 
 package mono.embeddinator;
 
-import com.sun.jna.*;
-
-public class UnsignedLong extends IntegerType {
-    public UnsignedLong() {
-         super(8, true);
+/**
+ * Holder for double ref parameters, which is also accepted by out
+ * parameters of the same type.
+ */
+public class DoubleRef extends DoubleOut {
+    public DoubleRef() {
     }
 
-    public UnsignedLong(long value) {
-         super(8, value, true);
+    public DoubleRef(double value) {
+        set(value);
     }
 }
-
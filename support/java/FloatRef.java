@@ -1,10 +1,7 @@
 /*
  * Mono Embeddinator-4000 Java support code.
  *
- * Author:
- *   Joao Matos (joao.matos@xamarin.com)
- *
- * (C) 2016 Microsoft, Inc.
+ * (C) 2017 Microsoft, Inc.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -28,15 +25,15 @@
 
 package mono.embeddinator;
 
-import com.sun.jna.*;
-
-public class UnsignedShort extends IntegerType {
-    public UnsignedShort() {
-         super(2, true);
+/**
+ * Holder for float ref parameters, which is also accepted by out
+ * parameters of the same type.
+ */
+public class FloatRef extends FloatOut {
+    public FloatRef() {
     }
 
-    public UnsignedShort(long value) {
-         super(2, value, true);
+    public FloatRef(float value) {
+        set(value);
     }
 }
-
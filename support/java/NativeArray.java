@@ -0,0 +1,248 @@
+/*
+ * Mono Embeddinator-4000 Java support code.
+ *
+ * (C) 2017 Microsoft, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+package mono.embeddinator;
+
+import com.sun.jna.*;
+import java.lang.ref.*;
+import java.nio.*;
+import java.util.*;
+
+/**
+ * Marshals arrays of primitive types as direct NIO buffers.
+ *
+ * Arguments are described to native code in place, and returned arrays are
+ * exposed over their native storage, which is released once the buffer is
+ * garbage collected.
+ */
+public final class NativeArray {
+    /** GArray header describing the storage of an argument. */
+    static final class Header extends Memory {
+        // Keeps the described storage alive for the duration of the call.
+        final Buffer storage;
+
+        Header(Buffer storage, int length) {
+            super(Native.POINTER_SIZE * 2);
+            this.storage = storage;
+            setPointer(0, Native.getDirectBufferPointer(storage));
+            setInt(Native.POINTER_SIZE, length);
+        }
+    }
+
+    /** Releases a returned array once its buffer is collected. */
+    static final class Owner extends PhantomReference<Buffer> {
+        final Pointer array;
+
+        Owner(Buffer buffer, Pointer array) {
+            super(buffer, queue);
+            this.array = array;
+        }
+    }
+
+    static final ReferenceQueue<Buffer> queue = new ReferenceQueue<Buffer>();
+
+    static final Set<Owner> owners = Collections.synchronizedSet(new HashSet<Owner>());
+
+    private NativeArray() {
+    }
+
+    static void releaseCollected() {
+        Reference<? extends Buffer> reference;
+        while ((reference = queue.poll()) != null) {
+            Owner owner = (Owner) reference;
+            owners.remove(owner);
+            Runtime.runtimeLibrary.mono_embeddinator_array_free(owner.array);
+        }
+    }
+
+    static ByteBuffer allocate(int length, int elementSize) {
+        return ByteBuffer.allocateDirect(length * elementSize).order(ByteOrder.nativeOrder());
+    }
+
+    static boolean isNativeOrder(Buffer buffer) {
+        ByteOrder order = ByteOrder.nativeOrder();
+        if (buffer instanceof ShortBuffer)
+            return ((ShortBuffer) buffer).order() == order;
+        if (buffer instanceof IntBuffer)
+            return ((IntBuffer) buffer).order() == order;
+        if (buffer instanceof LongBuffer)
+            return ((LongBuffer) buffer).order() == order;
+        if (buffer instanceof FloatBuffer)
+            return ((FloatBuffer) buffer).order() == order;
+        if (buffer instanceof DoubleBuffer)
+            return ((DoubleBuffer) buffer).order() == order;
+        return true;
+    }
+
+    /** Copies the remaining elements of a heap or byte-swapped buffer in bulk. */
+    static ByteBuffer copy(Buffer buffer, int elementSize) {
+        ByteBuffer bytes = allocate(buffer.remaining(), elementSize);
+        if (buffer instanceof ByteBuffer)
+            bytes.duplicate().put(((ByteBuffer) buffer).duplicate());
+        else if (buffer instanceof ShortBuffer)
+            bytes.asShortBuffer().put(((ShortBuffer) buffer).duplicate());
+        else if (buffer instanceof IntBuffer)
+            bytes.asIntBuffer().put(((IntBuffer) buffer).duplicate());
+        else if (buffer instanceof LongBuffer)
+            bytes.asLongBuffer().put(((LongBuffer) buffer).duplicate());
+        else if (buffer instanceof FloatBuffer)
+            bytes.asFloatBuffer().put(((FloatBuffer) buffer).duplicate());
+        else if (buffer instanceof DoubleBuffer)
+            bytes.asDoubleBuffer().put(((DoubleBuffer) buffer).duplicate());
+        else
+            throw new IllegalArgumentException("Unsupported buffer type " + buffer.getClass().getName());
+        return bytes;
+    }
+
+    /**
+     * Describes the remaining elements of a buffer as a MonoEmbedArray argument.
+     * Direct buffers in native byte order are passed without copying them.
+     */
+    public static Pointer describe(Buffer buffer, int elementSize) {
+        if (buffer == null)
+            return null;
+
+        int length = buffer.remaining();
+        if (!buffer.isDirect() || !isNativeOrder(buffer))
+            return new Header(copy(buffer, elementSize), length);
+
+        Buffer storage = buffer.position() == 0 ? buffer : slice(buffer);
+        return new Header(storage, length);
+    }
+
+    static Buffer slice(Buffer buffer) {
+        if (buffer instanceof ByteBuffer)
+            return ((ByteBuffer) buffer).slice();
+        if (buffer instanceof ShortBuffer)
+            return ((ShortBuffer) buffer).slice();
+        if (buffer instanceof IntBuffer)
+            return ((IntBuffer) buffer).slice();
+        if (buffer instanceof LongBuffer)
+            return ((LongBuffer) buffer).slice();
+        if (buffer instanceof FloatBuffer)
+            return ((FloatBuffer) buffer).slice();
+        return ((DoubleBuffer) buffer).slice();
+    }
+
+    /**
+     * Exposes the storage of a MonoEmbedArray returned by native code, which
+     * is released once the returned buffer and its views are collected.
+     */
+    static ByteBuffer wrap(Pointer array, int elementSize) {
+        releaseCollected();
+
+        if (array == null)
+            return null;
+
+        Pointer data = array.getPointer(0);
+        int length = array.getInt(Native.POINTER_SIZE);
+        if (data == null || length == 0) {
+            Runtime.runtimeLibrary.mono_embeddinator_array_free(array);
+            return allocate(0, elementSize);
+        }
+
+        ByteBuffer buffer = data.getByteBuffer(0, (long) length * elementSize);
+        buffer.order(ByteOrder.nativeOrder());
+        owners.add(new Owner(buffer, array));
+        return buffer;
+    }
+
+    public static ByteBuffer asByteBuffer(Pointer array) {
+        return wrap(array, 1);
+    }
+
+    public static ShortBuffer asShortBuffer(Pointer array) {
+        ByteBuffer buffer = wrap(array, 2);
+        return buffer == null ? null : buffer.asShortBuffer();
+    }
+
+    public static IntBuffer asIntBuffer(Pointer array) {
+        ByteBuffer buffer = wrap(array, 4);
+        return buffer == null ? null : buffer.asIntBuffer();
+    }
+
+    public static LongBuffer asLongBuffer(Pointer array) {
+        ByteBuffer buffer = wrap(array, 8);
+        return buffer == null ? null : buffer.asLongBuffer();
+    }
+
+    public static FloatBuffer asFloatBuffer(Pointer array) {
+        ByteBuffer buffer = wrap(array, 4);
+        return buffer == null ? null : buffer.asFloatBuffer();
+    }
+
+    public static DoubleBuffer asDoubleBuffer(Pointer array) {
+        ByteBuffer buffer = wrap(array, 8);
+        return buffer == null ? null : buffer.asDoubleBuffer();
+    }
+
+    public static ByteBuffer toBuffer(byte[] values) {
+        if (values == null)
+            return null;
+        ByteBuffer buffer = allocate(values.length, 1);
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    public static ShortBuffer toBuffer(short[] values) {
+        if (values == null)
+            return null;
+        ShortBuffer buffer = allocate(values.length, 2).asShortBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    public static IntBuffer toBuffer(int[] values) {
+        if (values == null)
+            return null;
+        IntBuffer buffer = allocate(values.length, 4).asIntBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    public static LongBuffer toBuffer(long[] values) {
+        if (values == null)
+            return null;
+        LongBuffer buffer = allocate(values.length, 8).asLongBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    public static FloatBuffer toBuffer(float[] values) {
+        if (values == null)
+            return null;
+        FloatBuffer buffer = allocate(values.length, 4).asFloatBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    public static DoubleBuffer toBuffer(double[] values) {
+        if (values == null)
+            return null;
+        DoubleBuffer buffer = allocate(values.length, 8).asDoubleBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+}
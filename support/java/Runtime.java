@@ -95,6 +95,11 @@ public final class Runtime {
         public void mono_embeddinator_set_assembly_path(String path);
         public void mono_embeddinator_set_runtime_assembly_path(String path);
         public Pointer mono_embeddinator_install_error_report_hook(ErrorCallback cb);
+
+        public void mono_embeddinator_string_free(Pointer string);
+
+        /** Takes the GArray of a MonoEmbedArray, which is passed by value as a pointer. */
+        public void mono_embeddinator_array_free(Pointer array);
     }
 
     private static DesktopImpl implementation;
@@ -139,6 +144,20 @@ public final class Runtime {
 
 
 
+    /**
+     * Decodes a UTF-8 string returned by native code, and releases it.
+     */
+    public static String takeString(Pointer string) {
+        if (string == null)
+            return null;
+
+        try {
+            return string.getString(0, "UTF-8");
+        } finally {
+            runtimeLibrary.mono_embeddinator_string_free(string);
+        }
+    }
+
     public static void checkExceptions() throws RuntimeException {
         RuntimeException exception = pendingException.get();
         pendingException.remove();
@@ -0,0 +1,142 @@
+/*
+ * Lazy loading of the Mono runtime
+ *
+ * Copyright (C) 2017 Microsoft Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+/*
+ * Redirects the calls to the Mono API made by the support and generated code
+ * through a DylibMono table, so the library does not link to the runtime and
+ * only loads it on the first call. Included by mono-support.h when building
+ * with MONO_EMBEDDINATOR_LAZY_RUNTIME defined.
+ *
+ * The runtime library is searched as MONO_EMBEDDINATOR_LIBMONO_PATH, which can
+ * be overridden when building, or as the MONO_EMBEDDINATOR_LIBMONO environment
+ * variable at runtime.
+ */
+
+MONO_EMBEDDINATOR_API
+extern DylibMono* mono_embeddinator_lazy_mono;
+
+/**
+ * Loads the runtime and its symbols on the first call.
+ * Aborts if the runtime cannot be loaded.
+ */
+MONO_EMBEDDINATOR_API
+DylibMono* mono_embeddinator_lazy_mono_load(void);
+
+static inline DylibMono* mono_embeddinator_get_lazy_mono(void)
+{
+    DylibMono* mono = __atomic_load_n(&mono_embeddinator_lazy_mono, __ATOMIC_ACQUIRE);
+    return mono ? mono : mono_embeddinator_lazy_mono_load();
+}
+
+#define MONO_EMBEDDINATOR_LAZY_CALL(symbol, ...) \
+    (mono_embeddinator_get_lazy_mono()->symbol(__VA_ARGS__))
+
+#define mono_method_desc_new(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_method_desc_new, __VA_ARGS__)
+#define mono_method_desc_free(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_method_desc_free, __VA_ARGS__)
+#define mono_method_desc_search_in_class(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_method_desc_search_in_class, __VA_ARGS__)
+#define mono_jit_cleanup(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_jit_cleanup, __VA_ARGS__)
+#define mono_domain_assembly_open(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_domain_assembly_open, __VA_ARGS__)
+#define mono_string_length(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_string_length, __VA_ARGS__)
+#define mono_string_chars(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_string_chars, __VA_ARGS__)
+#define mono_field_get_value_object(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_field_get_value_object, __VA_ARGS__)
+#define mono_field_set_value(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_field_set_value, __VA_ARGS__)
+#define mono_class_vtable(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_vtable, __VA_ARGS__)
+#define mono_field_static_set_value(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_field_static_set_value, __VA_ARGS__)
+#define mono_object_to_string(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_to_string, __VA_ARGS__)
+#define mono_class_get(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get, __VA_ARGS__)
+#define mono_class_get_field(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_field, __VA_ARGS__)
+#define mono_get_string_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_string_class)
+#define mono_get_boolean_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_boolean_class)
+#define mono_get_char_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_char_class)
+#define mono_get_sbyte_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_sbyte_class)
+#define mono_get_int16_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_int16_class)
+#define mono_get_int32_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_int32_class)
+#define mono_get_int64_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_int64_class)
+#define mono_get_byte_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_byte_class)
+#define mono_get_uint16_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_uint16_class)
+#define mono_get_uint32_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_uint32_class)
+#define mono_get_uint64_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_uint64_class)
+#define mono_get_single_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_single_class)
+#define mono_get_double_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_double_class)
+#define mono_array_element_size(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_array_element_size, __VA_ARGS__)
+
+#define mono_aot_register_module(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_aot_register_module, __VA_ARGS__)
+#define mono_array_addr_with_size(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_array_addr_with_size, __VA_ARGS__)
+#define mono_array_length(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_array_length, __VA_ARGS__)
+#define mono_array_new(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_array_new, __VA_ARGS__)
+#define mono_assembly_get_image(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_assembly_get_image, __VA_ARGS__)
+#define mono_class_array_element_size(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_array_element_size, __VA_ARGS__)
+#define mono_class_bind_generic_parameters(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_bind_generic_parameters, __VA_ARGS__)
+#define mono_class_from_name(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_from_name, __VA_ARGS__)
+#define mono_class_from_mono_type(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_from_mono_type, __VA_ARGS__)
+#define mono_class_get_element_class(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_element_class, __VA_ARGS__)
+#define mono_class_get_field_from_name(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_field_from_name, __VA_ARGS__)
+#define mono_class_get_image(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_image, __VA_ARGS__)
+#define mono_class_get_interfaces(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_interfaces, __VA_ARGS__)
+#define mono_class_get_method_from_name(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_method_from_name, __VA_ARGS__)
+#define mono_class_get_name(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_name, __VA_ARGS__)
+#define mono_class_get_namespace(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_namespace, __VA_ARGS__)
+#define mono_class_get_parent(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_parent, __VA_ARGS__)
+#define mono_class_get_rank(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_rank, __VA_ARGS__)
+#define mono_class_get_type(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_class_get_type, __VA_ARGS__)
+#define mono_config_parse(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_config_parse, __VA_ARGS__)
+#define mono_domain_get() MONO_EMBEDDINATOR_LAZY_CALL(mono_domain_get)
+#define mono_domain_set_config(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_domain_set_config, __VA_ARGS__)
+#define mono_field_get_value(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_field_get_value, __VA_ARGS__)
+#define mono_free(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_free, __VA_ARGS__)
+#define mono_gc_wbarrier_set_arrayref(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_gc_wbarrier_set_arrayref, __VA_ARGS__)
+#define mono_gchandle_free(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_gchandle_free, __VA_ARGS__)
+#define mono_gchandle_get_target(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_gchandle_get_target, __VA_ARGS__)
+#define mono_gchandle_new(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_gchandle_new, __VA_ARGS__)
+#define mono_gchandle_new_weakref(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_gchandle_new_weakref, __VA_ARGS__)
+#define mono_get_corlib() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_corlib)
+#define mono_get_intptr_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_intptr_class)
+#define mono_get_method(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_get_method, __VA_ARGS__)
+#define mono_get_object_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_object_class)
+#define mono_get_uintptr_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_uintptr_class)
+#define mono_get_void_class() MONO_EMBEDDINATOR_LAZY_CALL(mono_get_void_class)
+#define mono_jit_init_version(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_jit_init_version, __VA_ARGS__)
+#define mono_jit_parse_options(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_jit_parse_options, __VA_ARGS__)
+#define mono_jit_set_aot_mode(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_jit_set_aot_mode, __VA_ARGS__)
+#define mono_method_get_unmanaged_thunk(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_method_get_unmanaged_thunk, __VA_ARGS__)
+#define mono_method_signature(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_method_signature, __VA_ARGS__)
+#define mono_object_get_class(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_get_class, __VA_ARGS__)
+#define mono_object_get_domain(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_get_domain, __VA_ARGS__)
+#define mono_object_get_virtual_method(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_get_virtual_method, __VA_ARGS__)
+#define mono_object_new(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_new, __VA_ARGS__)
+#define mono_object_unbox(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_object_unbox, __VA_ARGS__)
+#define mono_register_bundled_assemblies(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_register_bundled_assemblies, __VA_ARGS__)
+#define mono_runtime_invoke(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_runtime_invoke, __VA_ARGS__)
+#define mono_set_dirs(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_set_dirs, __VA_ARGS__)
+#define mono_signature_get_params(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_signature_get_params, __VA_ARGS__)
+#define mono_string_new(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_string_new, __VA_ARGS__)
+#define mono_string_to_utf8(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_string_to_utf8, __VA_ARGS__)
+#define mono_threads_attach_coop(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_threads_attach_coop, __VA_ARGS__)
+#define mono_threads_detach_coop(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_threads_detach_coop, __VA_ARGS__)
+#define mono_type_get_object(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_type_get_object, __VA_ARGS__)
+#define mono_value_box(...) MONO_EMBEDDINATOR_LAZY_CALL(mono_value_box, __VA_ARGS__)
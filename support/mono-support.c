@@ -28,6 +28,7 @@
 
 #if !defined(_WIN32)
 
+#include <stdlib.h>
 #include <string.h>
 #include <dlfcn.h>
 
@@ -113,11 +114,12 @@ int mono_embeddinator_dylib_mono_init (struct DylibMono *mono_imports, const cha
 	LOAD_SYMBOL(mono_get_single_class)
 	LOAD_SYMBOL(mono_get_double_class)
 	LOAD_SYMBOL(mono_array_element_size)
+	MONO_EMBEDDINATOR_DYLIB_MONO_SYMBOLS(LOAD_SYMBOL)
 
 	if (symbols_missing) {
 		log_fatal (LOG_DEFAULT, "Failed to load some Mono symbols, aborting...");
 
-		mono_embeddinator_error_t error;
+		mono_embeddinator_error_t error = { 0 };
 		error.type = MONO_EMBEDDINATOR_MONO_RUNTIME_MISSING_SYMBOLS;
 		mono_embeddinator_error(error);
 
@@ -127,4 +129,48 @@ int mono_embeddinator_dylib_mono_init (struct DylibMono *mono_imports, const cha
 	return true;
 }
 
+#if defined(MONO_EMBEDDINATOR_LAZY_RUNTIME)
+
+#include <pthread.h>
+
+#ifndef MONO_EMBEDDINATOR_LIBMONO_PATH
+#if defined(__APPLE__)
+#define MONO_EMBEDDINATOR_LIBMONO_PATH "libmonosgen-2.0.dylib"
+#else
+#define MONO_EMBEDDINATOR_LIBMONO_PATH "libmonosgen-2.0.so.1"
+#endif
+#endif
+
+DylibMono* mono_embeddinator_lazy_mono = NULL;
+
+static DylibMono lazy_mono;
+static pthread_once_t lazy_mono_once = PTHREAD_ONCE_INIT;
+
+static void lazy_mono_load_once(void)
+{
+	const char *path = getenv ("MONO_EMBEDDINATOR_LIBMONO");
+	if (!path)
+		path = MONO_EMBEDDINATOR_LIBMONO_PATH;
+
+	if (!mono_embeddinator_dylib_mono_init (&lazy_mono, path)) {
+		mono_embeddinator_error_t error = { 0 };
+		error.type = MONO_EMBEDDINATOR_MONO_RUNTIME_MISSING_SYMBOLS;
+		error.string = path;
+		mono_embeddinator_error(error);
+
+		/* None of the generated code can run without the runtime. */
+		abort ();
+	}
+
+	__atomic_store_n (&mono_embeddinator_lazy_mono, &lazy_mono, __ATOMIC_RELEASE);
+}
+
+DylibMono* mono_embeddinator_lazy_mono_load(void)
+{
+	pthread_once (&lazy_mono_once, lazy_mono_load_once);
+	return mono_embeddinator_lazy_mono;
+}
+
+#endif
+
 #endif
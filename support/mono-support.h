@@ -116,6 +116,18 @@ typedef struct _MonoClassField MonoClassField;
 /* metadata/debug-helpers.h */
 typedef struct MonoMethodDesc MonoMethodDesc;
 
+#include <mono/jit/jit.h>
+#include <mono/metadata/mono-config.h>
+#include <mono/metadata/assembly.h>
+#include <mono/metadata/debug-helpers.h>
+#include <mono/metadata/object.h>
+
+gpointer
+mono_threads_attach_coop (MonoDomain *domain, gpointer *dummy);
+
+void
+mono_threads_detach_coop (gpointer cookie, gpointer *dummy);
+
 #if !defined(_WIN32)
 typedef MonoMethodDesc* (*_mono_method_desc_new_fptr) (const char *name, mono_bool include_namespace);
 typedef void            (*_mono_method_desc_free_fptr) (MonoMethodDesc *desc);
@@ -147,6 +159,68 @@ typedef MonoClass*      (*_mono_get_single_class_fptr) (void);
 typedef MonoClass*      (*_mono_get_double_class_fptr) (void);
 typedef int             (*_mono_array_element_size_fptr) (MonoClass *ac);
 
+/*
+ * The rest of the Mono API used by the support and generated code, which is
+ * loaded along with the symbols above when the runtime is loaded lazily.
+ * The members are declared with the types of the Mono headers.
+ */
+#define MONO_EMBEDDINATOR_DYLIB_MONO_SYMBOLS(X) \
+	X(mono_aot_register_module) \
+	X(mono_array_addr_with_size) \
+	X(mono_array_length) \
+	X(mono_array_new) \
+	X(mono_assembly_get_image) \
+	X(mono_class_array_element_size) \
+	X(mono_class_bind_generic_parameters) \
+	X(mono_class_from_name) \
+	X(mono_class_from_mono_type) \
+	X(mono_class_get_element_class) \
+	X(mono_class_get_field_from_name) \
+	X(mono_class_get_image) \
+	X(mono_class_get_interfaces) \
+	X(mono_class_get_method_from_name) \
+	X(mono_class_get_name) \
+	X(mono_class_get_namespace) \
+	X(mono_class_get_parent) \
+	X(mono_class_get_rank) \
+	X(mono_class_get_type) \
+	X(mono_config_parse) \
+	X(mono_domain_get) \
+	X(mono_domain_set_config) \
+	X(mono_field_get_value) \
+	X(mono_free) \
+	X(mono_gc_wbarrier_set_arrayref) \
+	X(mono_gchandle_free) \
+	X(mono_gchandle_get_target) \
+	X(mono_gchandle_new) \
+	X(mono_gchandle_new_weakref) \
+	X(mono_get_corlib) \
+	X(mono_get_intptr_class) \
+	X(mono_get_method) \
+	X(mono_get_object_class) \
+	X(mono_get_uintptr_class) \
+	X(mono_get_void_class) \
+	X(mono_jit_init_version) \
+	X(mono_jit_parse_options) \
+	X(mono_jit_set_aot_mode) \
+	X(mono_method_get_unmanaged_thunk) \
+	X(mono_method_signature) \
+	X(mono_object_get_class) \
+	X(mono_object_get_domain) \
+	X(mono_object_get_virtual_method) \
+	X(mono_object_new) \
+	X(mono_object_unbox) \
+	X(mono_register_bundled_assemblies) \
+	X(mono_runtime_invoke) \
+	X(mono_set_dirs) \
+	X(mono_signature_get_params) \
+	X(mono_string_new) \
+	X(mono_string_to_utf8) \
+	X(mono_threads_attach_coop) \
+	X(mono_threads_detach_coop) \
+	X(mono_type_get_object) \
+	X(mono_value_box)
+
 /* NOTE: structure members MUST NOT CHANGE ORDER. */
 typedef struct DylibMono {
 	void                                    *dl_handle;
@@ -179,6 +253,9 @@ typedef struct DylibMono {
 	_mono_get_single_class_fptr              mono_get_single_class;
 	_mono_get_double_class_fptr              mono_get_double_class;
 	_mono_array_element_size_fptr            mono_array_element_size;
+#define MONO_EMBEDDINATOR_DYLIB_MONO_MEMBER(symbol) __typeof__(symbol) *symbol;
+	MONO_EMBEDDINATOR_DYLIB_MONO_SYMBOLS(MONO_EMBEDDINATOR_DYLIB_MONO_MEMBER)
+#undef MONO_EMBEDDINATOR_DYLIB_MONO_MEMBER
 } DylibMono;
 
 MONO_EMBEDDINATOR_API DylibMono*
@@ -189,19 +266,11 @@ mono_embeddinator_dylib_mono_free (struct DylibMono *mono_imports);
 
 MONO_EMBEDDINATOR_API int
 mono_embeddinator_dylib_mono_init (struct DylibMono *mono_imports, const char *libmono_path);
-#endif
-
-#include <mono/jit/jit.h>
-#include <mono/metadata/mono-config.h>
-#include <mono/metadata/assembly.h>
-#include <mono/metadata/debug-helpers.h>
-#include <mono/metadata/object.h>
 
-gpointer
-mono_threads_attach_coop (MonoDomain *domain, gpointer *dummy);
-
-void
-mono_threads_detach_coop (gpointer cookie, gpointer *dummy);
+#if defined(MONO_EMBEDDINATOR_LAZY_RUNTIME)
+#include "mono-lazy.h"
+#endif
+#endif
 
 #define MONO_THREAD_ATTACH \
 	do { \
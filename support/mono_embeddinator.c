@@ -94,11 +94,176 @@ static gchar* strrchr_seperator (const gchar* filename)
 
 static GString* path_override = NULL;
 
+static mono_embeddinator_aot_mode_t aot_mode = MONO_EMBEDDINATOR_AOT_NONE;
+
+void mono_embeddinator_set_aot_mode(mono_embeddinator_aot_mode_t mode)
+{
+    aot_mode = mode;
+}
+
+static const MonoBundledAssembly** bundled_assemblies = NULL;
+
+void mono_embeddinator_register_bundled_assemblies(const MonoBundledAssembly** assemblies)
+{
+    bundled_assemblies = assemblies;
+}
+
+static void** const* aot_modules = NULL;
+
+void mono_embeddinator_register_aot_modules(void** const* modules)
+{
+    aot_modules = modules;
+}
+
+static bool is_bundled_assembly(const char* assembly)
+{
+    if (!bundled_assemblies)
+        return false;
+
+    for (const MonoBundledAssembly** bundled = bundled_assemblies; *bundled; bundled++)
+    {
+        if (strcmp((*bundled)->name, assembly) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Bundled assemblies are opened by name, which the runtime resolves from
+ * memory, so they do not need to be searched on disk.
+ */
+static char* resolve_assembly_path(const char* assembly)
+{
+    if (is_bundled_assembly(assembly))
+        return g_strdup(assembly);
+
+    return mono_embeddinator_search_assembly(assembly);
+}
+
 int mono_embeddinator_init(mono_embeddinator_context_t* ctx, const char* domain)
 {
-    if (ctx == 0 || ctx->domain != 0)
+    mono_embeddinator_init_options_t options;
+    memset(&options, 0, sizeof(options));
+    options.domain = domain;
+
+    return mono_embeddinator_init_with_options(ctx, &options);
+}
+
+#if !defined (XAMARIN_IOS) && !defined (XAMARIN_MAC) && !defined (__ANDROID__)
+/**
+ * The GC reads its parameters from the environment when the runtime starts,
+ * so the options are prepended to the ones already set there. Returns true if
+ * the environment was changed, with the previous value of MONO_GC_PARAMS, or
+ * NULL if it was not set, to be restored by restore_gc_params.
+ */
+static bool set_gc_params(const mono_embeddinator_init_options_t* options, char** previous)
+{
+    bool changed = false;
+    *previous = NULL;
+
+    GString* params = g_string_new("");
+
+    if (options->nursery_size)
+    {
+        char nursery_size[32];
+        snprintf(nursery_size, sizeof(nursery_size), "nursery-size=%llu,",
+            (unsigned long long) options->nursery_size);
+        g_string_append(params, nursery_size);
+    }
+
+    const char* major = options->major_collector;
+    if (!major && options->gc_mode == MONO_EMBEDDINATOR_GC_CONCURRENT)
+        major = "marksweep-conc";
+    else if (!major && options->gc_mode == MONO_EMBEDDINATOR_GC_NON_CONCURRENT)
+        major = "marksweep";
+
+    if (major)
+    {
+        g_string_append(params, "major=");
+        g_string_append(params, major);
+        g_string_append_c(params, ',');
+    }
+
+    if (options->gc_params && *options->gc_params)
+    {
+        g_string_append(params, options->gc_params);
+        g_string_append_c(params, ',');
+    }
+
+    if (params->len)
+    {
+        const char* env = getenv("MONO_GC_PARAMS");
+        if (env && *env)
+            g_string_append(params, env);
+        else
+            g_string_truncate(params, params->len - 1);
+
+        *previous = env ? g_strdup(env) : NULL;
+        changed = true;
+
+#ifdef _WIN32
+        _putenv_s("MONO_GC_PARAMS", params->str);
+#else
+        setenv("MONO_GC_PARAMS", params->str, 1);
+#endif
+    }
+
+    g_string_free(params, /*free_segment=*/ TRUE);
+    return changed;
+}
+
+/**
+ * Puts back the MONO_GC_PARAMS the process had once the runtime read it, so
+ * the processes started later do not inherit the GC options of the bindings.
+ */
+static void restore_gc_params(char* previous)
+{
+#ifdef _WIN32
+    // Setting an empty value removes the variable.
+    _putenv_s("MONO_GC_PARAMS", previous ? previous : "");
+#else
+    if (previous)
+        setenv("MONO_GC_PARAMS", previous, 1);
+    else
+        unsetenv("MONO_GC_PARAMS");
+#endif
+
+    g_free(previous);
+}
+
+static void set_jit_options(const mono_embeddinator_init_options_t* options)
+{
+    char* argv[2];
+    int argc = 0;
+
+    GString* optimize = 0;
+    if (options->jit_optimizations && *options->jit_optimizations)
+    {
+        optimize = g_string_new("--optimize=");
+        g_string_append(optimize, options->jit_optimizations);
+        argv[argc++] = optimize->str;
+    }
+
+    if (options->use_llvm)
+        argv[argc++] = (char*) "--llvm";
+
+    if (argc)
+        mono_jit_parse_options(argc, argv);
+
+    if (optimize)
+        g_string_free(optimize, /*free_segment=*/ TRUE);
+}
+#endif
+
+int mono_embeddinator_init_with_options(mono_embeddinator_context_t* ctx,
+    const mono_embeddinator_init_options_t* options)
+{
+    if (ctx == 0 || ctx->domain != 0 || options == 0)
         return false;
 
+    const char* domain = options->domain ? options->domain : "mono_embeddinator_binding";
+
 #if defined (XAMARIN_IOS) || defined (XAMARIN_MAC)
     xamarin_initialize_embedded ();
     ctx->domain = mono_domain_get ();
@@ -106,16 +271,50 @@ int mono_embeddinator_init(mono_embeddinator_context_t* ctx, const char* domain)
     #if defined (__ANDROID__)
     ctx->domain = mono_domain_get ();
     #else
-    mono_config_parse(NULL);
+    if (!options->skip_config)
+        mono_config_parse(NULL);
+    char* previous_gc_params;
+    bool gc_params_changed = set_gc_params(options, &previous_gc_params);
+    set_jit_options(options);
+    if (bundled_assemblies)
+        mono_register_bundled_assemblies(bundled_assemblies);
+    if (aot_modules)
+    {
+        for (void** const* module = aot_modules; *module; module++)
+            mono_aot_register_module(*module);
+    }
+    if (aot_mode == MONO_EMBEDDINATOR_AOT_FULL)
+        mono_jit_set_aot_mode(MONO_AOT_MODE_FULL);
+    else if (aot_mode == MONO_EMBEDDINATOR_AOT_NORMAL)
+        mono_jit_set_aot_mode(MONO_AOT_MODE_NORMAL);
     ctx->domain = mono_jit_init_version(domain, "v4.0.30319");
+    if (gc_params_changed)
+        restore_gc_params(previous_gc_params);
     #endif
 #endif
 
     mono_embeddinator_set_context(ctx);
 
-    char cwd[PATH_MAX];
-    getcwd(cwd, PATH_MAX);
-    mono_domain_set_config(ctx->domain, cwd, "app.config");
+    if (options->app_config)
+    {
+        const gchar* sep = strrchr_seperator(options->app_config);
+        if (sep)
+        {
+            GString* dir = g_string_new_len(options->app_config, sep - options->app_config);
+            mono_domain_set_config(ctx->domain, dir->str, sep + 1);
+            g_string_free(dir, /*free_segment=*/ TRUE);
+        }
+        else
+        {
+            mono_domain_set_config(ctx->domain, ".", options->app_config);
+        }
+    }
+    else if (!options->skip_config)
+    {
+        char cwd[PATH_MAX];
+        getcwd(cwd, PATH_MAX);
+        mono_domain_set_config(ctx->domain, cwd, "app.config");
+    }
 
     return true;
 }
@@ -209,7 +408,7 @@ MonoImage* mono_embeddinator_load_assembly(mono_embeddinator_context_t* ctx, con
     mono_assembly = xamarin_open_assembly (assembly);
 #else
 
-    path = mono_embeddinator_search_assembly(assembly);
+    path = resolve_assembly_path(assembly);
 
     mono_assembly = mono_domain_assembly_open (ctx->domain, path);
 #endif
@@ -246,7 +445,7 @@ MonoClass* mono_embeddinator_search_class(const char* assembly, const char* _nam
 {
     mono_embeddinator_context_t* ctx = mono_embeddinator_get_context();
 
-    char* path = mono_embeddinator_search_assembly(assembly);
+    char* path = resolve_assembly_path(assembly);
     MonoAssembly* mono_assembly = mono_domain_assembly_open(ctx->domain, path);
 
     if (mono_assembly == 0)
@@ -320,6 +519,8 @@ char* mono_embeddinator_error_to_string(mono_embeddinator_error_t error)
         return "Mono failed to lookup method";
     case MONO_EMBEDDINATOR_MONO_RUNTIME_MISSING_SYMBOLS:
         return "Failed to load Mono runtime shared libary symbols";
+    case MONO_EMBEDDINATOR_CALLBACK_SLOTS_EXHAUSTED:
+        return "All the native callback slots are in use";
     }
 
     g_assert_not_reached();
@@ -48,6 +48,96 @@ typedef struct
 MONO_EMBEDDINATOR_API
 int mono_embeddinator_init(mono_embeddinator_context_t* ctx, const char* domain);
 
+/**
+ * Represents whether the major collections of the GC run concurrently.
+ */
+typedef enum
+{
+    // The default of the runtime
+    MONO_EMBEDDINATOR_GC_DEFAULT = 0,
+    // Marking runs concurrently with the application threads
+    MONO_EMBEDDINATOR_GC_CONCURRENT,
+    // The application threads are stopped for the whole major collection
+    MONO_EMBEDDINATOR_GC_NON_CONCURRENT
+} mono_embeddinator_gc_mode_t;
+
+/**
+ * Options of the runtime started by mono_embeddinator_init_with_options.
+ * Zeroed members keep the defaults of mono_embeddinator_init. The GC and JIT
+ * options have no effect on the mobile platforms, where the runtime is
+ * started by the host.
+ */
+typedef struct
+{
+    // Name of the application domain.
+    const char* domain;
+    // Size of the GC nursery in bytes, which must be a power of two.
+    uint64_t nursery_size;
+    // Major collector, such as "marksweep" or "marksweep-conc". Takes
+    // precedence over gc_mode.
+    const char* major_collector;
+    mono_embeddinator_gc_mode_t gc_mode;
+    // Additional GC parameters, in the format of MONO_GC_PARAMS. Parameters
+    // set in the MONO_GC_PARAMS environment variable take precedence. The
+    // variable is restored once the runtime has started.
+    const char* gc_params;
+    // JIT optimizations, in the format of the --optimize option of mono,
+    // such as "all,-inline".
+    const char* jit_optimizations;
+    // Compiles methods with LLVM, if the runtime supports it.
+    bool use_llvm;
+    // Skips parsing the Mono configuration file and probing for app.config.
+    bool skip_config;
+    // Path of the configuration file of the domain, instead of app.config
+    // in the current directory.
+    const char* app_config;
+} mono_embeddinator_init_options_t;
+
+/**
+ * Initializes a managed-to-native binding context, starting the runtime with
+ * the given options. Returns a boolean indicating success or failure.
+ */
+MONO_EMBEDDINATOR_API
+int mono_embeddinator_init_with_options(mono_embeddinator_context_t* ctx,
+    const mono_embeddinator_init_options_t* options);
+
+/**
+ * Represents how managed code is compiled by the desktop runtime.
+ */
+typedef enum
+{
+    // Methods are JIT compiled on their first call
+    MONO_EMBEDDINATOR_AOT_NONE = 0,
+    // Precompiled AOT images are used when found next to the assemblies,
+    // falling back to the JIT for the code they do not cover
+    MONO_EMBEDDINATOR_AOT_NORMAL,
+    // Only precompiled code is used and the JIT is disabled
+    MONO_EMBEDDINATOR_AOT_FULL
+} mono_embeddinator_aot_mode_t;
+
+/**
+ * Sets how managed code is compiled. Needs to be called before the context
+ * is initialized, and has no effect on the mobile platforms.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_set_aot_mode(mono_embeddinator_aot_mode_t mode);
+
+/**
+ * Registers assemblies embedded in the library, which are then loaded from
+ * memory by name instead of being searched on disk. The NULL-terminated array
+ * and the assembly data need to outlive the runtime. Needs to be called
+ * before the context is initialized.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_register_bundled_assemblies(const MonoBundledAssembly** assemblies);
+
+/**
+ * Registers AOT modules statically linked into the library, as a
+ * NULL-terminated array. Needs to be called before the context is initialized.
+ */
+MONO_EMBEDDINATOR_API
+void mono_embeddinator_register_aot_modules(void** const* modules);
+
 /** 
  * Destroys the managed-to-native binding context.
  * Returns a boolean indicating success or failure.
@@ -137,7 +227,9 @@ typedef enum
     // Mono failed to lookup method
     MONO_EMBEDDINATOR_METHOD_LOOKUP_FAILED,
     // Failed to load Mono runtime shared library symbols
-    MONO_EMBEDDINATOR_MONO_RUNTIME_MISSING_SYMBOLS
+    MONO_EMBEDDINATOR_MONO_RUNTIME_MISSING_SYMBOLS,
+    // All the native callback slots of a delegate type are in use
+    MONO_EMBEDDINATOR_CALLBACK_SLOTS_EXHAUSTED
 } mono_embeddinator_error_type_t;
 
 /**
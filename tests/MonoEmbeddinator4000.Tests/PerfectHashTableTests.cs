@@ -0,0 +1,76 @@
+using System.Collections.Generic;
+using System.Linq;
+using Embeddinator.Generators;
+using NUnit.Framework;
+
+namespace Embeddinator.Tests
+{
+    [TestFixture]
+    public class PerfectHashTableTests
+    {
+        // Same lookup as mono_embeddinator_lookup_dynamic in c-support.c.
+        static string Lookup(PerfectHashTable table, string name)
+        {
+            var count = (uint)table.Slots.Length;
+            var displacement = table.Displacements[PerfectHashTable.Hash(0, name) % count];
+            var slot = displacement < 0 ? (uint)(-displacement - 1) :
+                PerfectHashTable.Hash((uint)displacement, name) % count;
+
+            return table.Slots[slot] == name ? table.Slots[slot] : null;
+        }
+
+        static List<string> GetNames(int count)
+        {
+            return Enumerable.Range(0, count).Select(i => $"Namespace_Class{i / 10}_Method{i}").ToList();
+        }
+
+        [Test]
+        public void FindsAllNames()
+        {
+            var names = GetNames(1000);
+            var table = PerfectHashTable.Build(names);
+
+            CollectionAssert.AreEquivalent(names, table.Slots);
+
+            foreach (var name in names)
+                Assert.AreEqual(name, Lookup(table, name));
+        }
+
+        [Test]
+        public void FindsCollidingNames()
+        {
+            var names = GetNames(1000);
+            var table = PerfectHashTable.Build(names);
+
+            var colliding = names.GroupBy(name => PerfectHashTable.Hash(0, name) % (uint)names.Count)
+                .Where(bucket => bucket.Count() > 1)
+                .SelectMany(bucket => bucket)
+                .ToList();
+
+            Assert.IsNotEmpty(colliding);
+
+            foreach (var name in colliding)
+                Assert.AreEqual(name, Lookup(table, name));
+        }
+
+        [Test]
+        public void MissesOtherNames()
+        {
+            var names = GetNames(1000);
+            var table = PerfectHashTable.Build(names);
+
+            foreach (var name in new[] { string.Empty, "Namespace_Class0_Method", "Namespace_Class0_Method0_",
+                "Namespace_Class100_Method1000", "Other" })
+                Assert.IsNull(Lookup(table, name));
+        }
+
+        [Test]
+        public void FindsSingleName()
+        {
+            var table = PerfectHashTable.Build(new[] { "Foo_Bar" });
+
+            Assert.AreEqual("Foo_Bar", Lookup(table, "Foo_Bar"));
+            Assert.IsNull(Lookup(table, "Foo_Baz"));
+        }
+    }
+}
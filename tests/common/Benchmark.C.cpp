@@ -0,0 +1,45 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "managed.h"
+#include "c-support.h"
+
+// Measures the average time of a few representative calls through the C
+// bindings, so builds of the bindings with different options can be compared.
+
+template<typename Call>
+static void Measure(const char* name, int iterations, Call call)
+{
+    // Warm up the lookups and the JIT before timing.
+    for (int i = 0; i < 1000; i++)
+        call(i);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        call(i);
+    auto end = std::chrono::steady_clock::now();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("%-24s %10.1f ns/call\n", name, elapsed / iterations);
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    Methods_Static* object = Methods_Static_Create(1);
+
+    Measure("Int32 getter", iterations, [&](int) {
+        Methods_Static_get_Id(object);
+    });
+
+    Measure("Object factory", iterations, [&](int i) {
+        mono_embeddinator_destroy_object((MonoEmbedObject*) Methods_Static_Create(i));
+    });
+
+    Measure("String method", iterations, [&](int) {
+        mono_embeddinator_string_free(Methods_Parameters_Concat("first", "second"));
+    });
+
+    return 0;
+}
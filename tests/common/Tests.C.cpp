@@ -47,6 +47,13 @@ TEST_CASE("Types.C", "[C][Types]") {
     REQUIRE(strcmp(Type_String_get_EmptyString(), "") == 0);
     REQUIRE(strcmp(Type_String_get_NonEmptyString(), "Hello World") == 0);
 
+    REQUIRE(Type_Int32_Min == INT32_MIN);
+    REQUIRE(Type_Int64_Max == INT64_MAX);
+    REQUIRE(Type_UInt64_Max == UINT64_MAX);
+    REQUIRE(Type_Double_Min == -DBL_MAX);
+    REQUIRE(Type_Char_Max == UINT16_MAX);
+    REQUIRE(strcmp(Type_String_NonEmptyString, "Hello World") == 0);
+
     GString* result;
 
     MonoDecimal decimalmax = Type_Decimal_get_Max();
@@ -141,6 +148,42 @@ TEST_CASE("Properties.C", "[C][Properties]") {
     REQUIRE(Properties_Query_get_IsSecret(prop) == false);
     Properties_Query_set_Secret(prop, 1);
     REQUIRE(Properties_Query_get_IsSecret(prop) == true);
+
+    Properties_Query_Snapshot snapshot;
+    Properties_Query_snapshot(prop, &snapshot);
+    REQUIRE(snapshot.IsGood == true);
+    REQUIRE(snapshot.IsBad == false);
+    REQUIRE(snapshot.Answer == 911);
+    REQUIRE(snapshot.IsSecret == true);
+}
+
+static MonoException* lastException;
+
+static void RecordException(mono_embeddinator_error_t error)
+{
+    if (error.type == MONO_EMBEDDINATOR_EXCEPTION_THROWN)
+        lastException = error.exception;
+}
+
+TEST_CASE("Snapshots.C", "[C][Properties]") {
+    Properties_Partial_Snapshot snapshot;
+    Properties_Partial* partial = Properties_Partial_new(/*broken=*/false);
+    Properties_Partial_snapshot(partial, &snapshot);
+    REQUIRE(strcmp(snapshot.Name, "Partial") == 0);
+    REQUIRE(Properties_Query_get_Answer(snapshot.Query) == 42);
+    REQUIRE(snapshot.Value == 42);
+    mono_embeddinator_string_free(snapshot.Name);
+    mono_embeddinator_destroy_object((MonoEmbedObject*) snapshot.Query);
+
+    // The name and query read before the throwing getter are released.
+    Properties_Partial* broken = Properties_Partial_new(/*broken=*/true);
+    lastException = NULL;
+    mono_embeddinator_install_error_report_hook(RecordException);
+    Properties_Partial_snapshot(broken, &snapshot);
+    mono_embeddinator_install_error_report_hook(0);
+    REQUIRE(lastException != NULL);
+    REQUIRE(strcmp(mono_class_get_name(mono_object_get_class((MonoObject*) lastException)),
+        "InvalidOperationException") == 0);
 }
 
 TEST_CASE("Namespaces.C", "[C][Namespaces]") {
@@ -209,6 +252,17 @@ TEST_CASE("Methods.C", "[C][Methods]") {
     REQUIRE(strcmp(Methods_Parameters_Concat(NULL, "second"), "second") == 0);
     REQUIRE(strcmp(Methods_Parameters_Concat("first", "second"), "firstsecond") == 0);
 
+    MonoEmbedStringView view = Methods_Parameters_Concat_view("first", "second");
+    REQUIRE(view.len == 11);
+    REQUIRE(view.chars[0] == 'f');
+    REQUIRE(view.chars[10] == 'd');
+    mono_embeddinator_string_view_release(&view);
+    REQUIRE(view.chars == NULL);
+
+    view = Methods_Parameters_Concat_view(NULL, NULL);
+    REQUIRE(view.chars == NULL);
+    mono_embeddinator_string_view_release(&view);
+
     bool b = true;
     GString* s = g_string_new(NULL);
     Methods_Parameters_Ref(&b, s);
@@ -313,6 +367,9 @@ TEST_CASE("Enums.C", "[C][Enums]") {
 
 TEST_CASE("FieldsInReference.C", "[C][Fields]") {
     REQUIRE(Fields_Class_get_MaxLong() == INT64_MAX);
+    REQUIRE(Fields_Class_MaxLong == INT64_MAX);
+    REQUIRE(Fields_Class_ReadOnlyInteger == 42);
+    REQUIRE(Fields_Class_get_ReadOnlyInteger() == 42);
 
     REQUIRE(Fields_Class_get_Integer() == 0);
     Fields_Class_set_Integer(1);
@@ -448,6 +505,329 @@ TEST_CASE("Arrays.C", "[C][Arrays]") {
     }
 }
 
+TEST_CASE("Hints.C", "[C][Hints]") {
+    REQUIRE(Hints_CachedStrings_Echo(NULL) == NULL);
+    REQUIRE(strcmp(Hints_CachedStrings_Echo("Mono"), "Mono") == 0);
+
+    char first[] = "cached-key";
+    char second[] = "cached-key";
+
+    mono_embeddinator_reset_stats();
+    Hints_CachedStrings_IsSameAsLast(first);
+    REQUIRE(Hints_CachedStrings_IsSameAsLast(second) == true);
+
+    mono_embeddinator_stats_t stats;
+    mono_embeddinator_get_stats(&stats);
+    REQUIRE(stats.string_cache_hits >= 1);
+
+    mono_embeddinator_string_cache_clear();
+    REQUIRE(Hints_CachedStrings_IsSameAsLast(first) == false);
+
+    REQUIRE(Hints_Promises_Add(1, 2) == 3);
+
+    int32_t squareCalls = Hints_Promises_get_SquareCalls();
+    REQUIRE(Hints_Promises_Square(3) == 9);
+    REQUIRE(Hints_Promises_Square(3) == 9);
+    REQUIRE(Hints_Promises_get_SquareCalls() == squareCalls + 1);
+    REQUIRE(Hints_Promises_Square(4) == 16);
+    REQUIRE(Hints_Promises_get_SquareCalls() == squareCalls + 2);
+
+    int32_t _values_arr[] = { 1, 2, 3 };
+    _Int32Array _values;
+    _values.array = g_array_sized_new(/*zero_terminated=*/false,
+        /*clear=*/true, sizeof(int32_t), G_N_ELEMENTS(_values_arr));
+    g_array_append_vals (_values.array, _values_arr, G_N_ELEMENTS(_values_arr));
+
+    mono_embeddinator_reset_stats();
+    REQUIRE(Hints_Promises_Sum(_values) == 6);
+    REQUIRE(Hints_Promises_Sum(_values) == 6);
+    mono_embeddinator_get_stats(&stats);
+    REQUIRE(stats.lent_array_reuses >= 1);
+
+    _Int32Array _empty;
+    _empty.array = g_array_new(/*zero_terminated=*/false, /*clear=*/true, sizeof(int32_t));
+    REQUIRE(Hints_Total_new(_empty) == NULL);
+    g_array_free(_empty.array, true);
+
+    mono_embeddinator_reset_stats();
+    REQUIRE(Hints_Total_get_Value(Hints_Total_new(_values)) == 6);
+    REQUIRE(Hints_Total_get_Value(Hints_Total_new(_values)) == 6);
+    mono_embeddinator_get_stats(&stats);
+    REQUIRE(stats.lent_array_reuses >= 1);
+    g_array_free(_values.array, true);
+
+    Hints_Size_Value size = { 2, 3 };
+    REQUIRE(Hints_Size_Area_value(size) == 6);
+    Hints_Size_Value scaled = Hints_Size_Scale_value(size, 2);
+    REQUIRE(scaled.Width == 4);
+    REQUIRE(scaled.Height == 6);
+}
+
+TEST_CASE("Enumerables.C", "[C][Enumerables]") {
+    int32_t chunk[256];
+    int64_t sum = 0;
+    int32_t count;
+
+    MonoEmbedIterator* range = Enumerables_Collections_Range(100000);
+    REQUIRE(mono_embeddinator_iterator_count(range) == 100000);
+    while ((count = mono_embeddinator_iterator_next(range, chunk, G_N_ELEMENTS(chunk))) > 0) {
+        for (int32_t i = 0; i < count; i++)
+            sum += chunk[i];
+    }
+    REQUIRE(count == 0);
+    REQUIRE(sum == 4999950000LL);
+    mono_embeddinator_iterator_destroy(range);
+
+    MonoEmbedIterator* list = Enumerables_Collections_List(5);
+    REQUIRE(mono_embeddinator_iterator_count(list) == 5);
+    REQUIRE(mono_embeddinator_iterator_next(list, chunk, 3) == 3);
+    REQUIRE(chunk[2] == 2);
+    REQUIRE(mono_embeddinator_iterator_next(list, chunk, 3) == 2);
+    REQUIRE(chunk[0] == 3);
+    REQUIRE(chunk[1] == 4);
+    REQUIRE(mono_embeddinator_iterator_next(list, chunk, 3) == 0);
+    mono_embeddinator_iterator_destroy(list);
+
+    int64_t longs[3];
+    MonoEmbedIterator* longsIterator = Enumerables_Collections_get_Longs();
+    REQUIRE(mono_embeddinator_iterator_next(longsIterator, longs, 3) == 3);
+    REQUIRE(longs[0] == INT64_MIN);
+    REQUIRE(longs[1] == 0);
+    REQUIRE(longs[2] == INT64_MAX);
+    mono_embeddinator_iterator_destroy(longsIterator);
+
+    Enumerables_Color colors[3];
+    MonoEmbedIterator* colorsIterator = Enumerables_Collections_get_Colors();
+    REQUIRE(mono_embeddinator_iterator_next(colorsIterator, colors, 3) == 3);
+    REQUIRE(colors[2] == Enumerables_Color_Blue);
+    mono_embeddinator_iterator_destroy(colorsIterator);
+
+    const char* strings[4];
+    MonoEmbedIterator* stringsIterator = Enumerables_Collections_Strings();
+    REQUIRE(mono_embeddinator_iterator_next(stringsIterator, strings, 4) == 3);
+    REQUIRE(strcmp(strings[0], "Hola") == 0);
+    REQUIRE(strings[1] == NULL);
+    REQUIRE(strcmp(strings[2], "Bonjour") == 0);
+    mono_embeddinator_iterator_destroy(stringsIterator);
+
+    Enumerables_Item* items[10];
+    MonoEmbedIterator* itemsIterator = Enumerables_Collections_Items(10);
+    REQUIRE(mono_embeddinator_iterator_count(itemsIterator) == 10);
+    REQUIRE(mono_embeddinator_iterator_next(itemsIterator, items, 10) == 10);
+    REQUIRE(Enumerables_Item_get_Value(items[9]) == 9);
+    mono_embeddinator_iterator_destroy(itemsIterator);
+
+    MonoEmbedIterator* lengths = Enumerables_Collections_get_Lengths();
+    REQUIRE(mono_embeddinator_iterator_count(lengths) == 3);
+    REQUIRE(mono_embeddinator_iterator_next(lengths, chunk, G_N_ELEMENTS(chunk)) == 3);
+    REQUIRE(chunk[0] == 1);
+    REQUIRE(chunk[2] == 3);
+    mono_embeddinator_iterator_destroy(lengths);
+
+    REQUIRE(Enumerables_Collections_get_Null() == NULL);
+
+    // Sequences are enumerated when the iterator is created.
+    REQUIRE(Enumerables_Collections_Throws() == NULL);
+}
+
+TEST_CASE("Tasks.C", "[C][Tasks]") {
+    MonoEmbedFuture* delay = Tasks_Async_Delay(10);
+    REQUIRE(mono_embeddinator_future_wait(delay, -1) == true);
+    REQUIRE(mono_embeddinator_future_status(delay) == MONO_EMBEDDINATOR_FUTURE_COMPLETED);
+    REQUIRE(mono_embeddinator_future_get_result(delay) == NULL);
+    mono_embeddinator_future_destroy(delay);
+
+    MonoEmbedFuture* add = Tasks_Async_Add(1, 2);
+    REQUIRE(Tasks_Async_Add_result(add) == 3);
+    REQUIRE(mono_embeddinator_future_is_completed(add) == true);
+    mono_embeddinator_future_destroy(add);
+
+    MonoEmbedFuture* echo = Tasks_Async_Echo("Mono");
+    REQUIRE(strcmp(Tasks_Async_Echo_result(echo), "Mono") == 0);
+    mono_embeddinator_future_destroy(echo);
+
+    MonoEmbedFuture* create = Tasks_Async_CreateItem("Item");
+    Tasks_Item* item = Tasks_Async_CreateItem_result(create);
+    REQUIRE(strcmp(Tasks_Item_get_Name(item), "Item") == 0);
+    mono_embeddinator_future_destroy(create);
+
+    MonoEmbedFuture* throws = Tasks_Async_Throws();
+    REQUIRE(mono_embeddinator_future_wait(throws, -1) == true);
+    REQUIRE(mono_embeddinator_future_status(throws) == MONO_EMBEDDINATOR_FUTURE_FAULTED);
+    mono_embeddinator_install_error_report_hook(RecordException);
+    REQUIRE(Tasks_Async_Throws_result(throws) == 0);
+    mono_embeddinator_install_error_report_hook(0);
+    REQUIRE(lastException != NULL);
+    REQUIRE(strcmp(mono_class_get_name(mono_object_get_class((MonoObject*) lastException)),
+        "InvalidOperationException") == 0);
+    mono_embeddinator_future_destroy(throws);
+
+    MonoEmbedFuture* futures[2];
+    futures[0] = Tasks_Async_get_Never();
+    futures[1] = Tasks_Async_Add(2, 3);
+    REQUIRE(mono_embeddinator_future_wait(futures[0], 10) == false);
+    REQUIRE(mono_embeddinator_future_status(futures[0]) == MONO_EMBEDDINATOR_FUTURE_PENDING);
+    REQUIRE(mono_embeddinator_future_wait_any(futures, 2, -1) == 1);
+    REQUIRE(mono_embeddinator_future_wait_any(futures, 1, 10) == -1);
+    mono_embeddinator_future_destroy(futures[0]);
+    mono_embeddinator_future_destroy(futures[1]);
+}
+
+static int32_t AddContext(int32_t value, void* context) {
+    return value + *(int32_t*)context;
+}
+
+static void AccumulateVisit(const char* name, int64_t value, void* context) {
+    *(int64_t*)context += value * (int64_t)strlen(name);
+}
+
+TEST_CASE("Callbacks.C", "[C][Callbacks]") {
+    int32_t offset = 10;
+    Callbacks_Transform* transform = Callbacks_Transform_new_callback(AddContext, &offset);
+    REQUIRE(transform != NULL);
+    REQUIRE(Callbacks_Invoker_Apply(transform, 5) == 15);
+    REQUIRE(Callbacks_Invoker_Sum(transform, 4) == 46);
+    REQUIRE(Callbacks_Transform_Invoke(transform, 1) == 11);
+
+    // The same function and context share the cached delegate.
+    Callbacks_Transform* same = Callbacks_Transform_new_callback(AddContext, &offset);
+    REQUIRE(Callbacks_Invoker_Apply(same, 0) == 10);
+    Callbacks_Transform_release_callback(same);
+
+    int32_t otherOffset = 100;
+    Callbacks_Transform* other = Callbacks_Transform_new_callback(AddContext, &otherOffset);
+    REQUIRE(Callbacks_Invoker_Apply(other, 5) == 105);
+    REQUIRE(Callbacks_Invoker_Apply(transform, 5) == 15);
+    Callbacks_Transform_release_callback(other);
+    Callbacks_Transform_release_callback(transform);
+
+    // Delegates still reachable from managed code keep their binding.
+    Callbacks_Transform* retained = Callbacks_Transform_new_callback(AddContext, &offset);
+    Callbacks_Invoker_Retain(retained);
+    Callbacks_Transform_release_callback(retained);
+    Callbacks_Transform* rebound = Callbacks_Transform_new_callback(AddContext, &otherOffset);
+    REQUIRE(Callbacks_Invoker_Apply(rebound, 5) == 105);
+    REQUIRE(Callbacks_Invoker_ApplyRetained(5) == 15);
+    Callbacks_Transform_release_callback(rebound);
+
+    int64_t total = 0;
+    Callbacks_Visitor* visitor = Callbacks_Visitor_new_callback(AccumulateVisit, &total);
+    Callbacks_Invoker_Visit(visitor);
+    REQUIRE(total == 9);
+    Callbacks_Visitor_release_callback(visitor);
+}
+
+TEST_CASE("Streams.C", "[C][Streams]") {
+    mono_embeddinator_reset_stats();
+
+    char buffer[16];
+    MonoEmbedStream* text = Streams_Source_Open("Hello Mono");
+    REQUIRE(mono_embeddinator_stream_length(text) == 10);
+    REQUIRE(mono_embeddinator_stream_read(text, buffer, 5) == 5);
+    REQUIRE(strncmp(buffer, "Hello", 5) == 0);
+    REQUIRE(mono_embeddinator_stream_seek(text, 0, 0) == 0);
+    REQUIRE(mono_embeddinator_stream_read(text, buffer, sizeof(buffer)) == 10);
+    REQUIRE(mono_embeddinator_stream_read(text, buffer, sizeof(buffer)) == 0);
+    mono_embeddinator_stream_destroy(text);
+
+    const int32_t length = 200000;
+    char* large = (char*)malloc(length);
+    MonoEmbedStream* source = Streams_Source_OpenLarge(length);
+    int32_t total = 0, read;
+    while ((read = mono_embeddinator_stream_read(source, large + total, length - total)) > 0)
+        total += read;
+    REQUIRE(total == length);
+    REQUIRE((unsigned char)large[length - 1] == (length - 1) % 251);
+    mono_embeddinator_stream_destroy(source);
+    free(large);
+
+    // Once the pool holds a buffer, reads reuse it instead of pinning new ones.
+    text = Streams_Source_Open("Hello Mono");
+    REQUIRE(mono_embeddinator_stream_read(text, buffer, 1) == 1);
+    mono_embeddinator_reset_stats();
+    for (int i = 1; i < 10; i++)
+        REQUIRE(mono_embeddinator_stream_read(text, buffer, 1) == 1);
+    mono_embeddinator_stream_destroy(text);
+
+    mono_embeddinator_stats_t reuse;
+    mono_embeddinator_get_stats(&reuse);
+    REQUIRE(reuse.stream_buffer_allocations == 0);
+
+    char input[] = "Native data";
+    MonoEmbedStream* memory = mono_embeddinator_stream_from_memory(input, strlen(input), false);
+    REQUIRE(strcmp(Streams_Sink_ReadAll(memory), "Native data") == 0);
+    mono_embeddinator_stream_destroy(memory);
+
+    unsigned char bytes[] = { 1, 2, 3, 4 };
+    memory = mono_embeddinator_stream_from_memory(bytes, sizeof(bytes), false);
+    REQUIRE(Streams_Sink_Sum(memory) == 10);
+    mono_embeddinator_stream_destroy(memory);
+
+    MonoEmbedStream* output = Streams_Source_CreateBuffer();
+    REQUIRE(mono_embeddinator_stream_write(output, "Mono", 4) == 4);
+    REQUIRE(mono_embeddinator_stream_flush(output) == true);
+    REQUIRE(strcmp(Streams_Sink_Decode(output), "Mono") == 0);
+    mono_embeddinator_stream_destroy(output);
+
+    mono_embeddinator_stats_t stats;
+    mono_embeddinator_get_stats(&stats);
+    REQUIRE(stats.stream_buffer_allocations <= 8);
+}
+
+TEST_CASE("DynamicInvoke.C", "[C][DynamicInvoke]") {
+    const mono_embeddinator_dynamic_entry_t* add = mono_embeddinator_lookup_dynamic("Hints_Promises_Add");
+    REQUIRE(add != NULL);
+    REQUIRE(strcmp(add->name, "Hints_Promises_Add") == 0);
+    REQUIRE(add->function == (void (*)()) Hints_Promises_Add);
+
+    int32_t a = 1, b = 2, sum = 0;
+    void* addArgs[] = { &a, &b };
+    mono_embeddinator_invoke_entry(add, addArgs, &sum);
+    REQUIRE(sum == 3);
+
+    Methods_Static* object = Methods_Static_Create(7);
+    int32_t id = 0;
+    void* idArgs[] = { &object };
+    REQUIRE(mono_embeddinator_invoke_dynamic("Methods_Static_get_Id", idArgs, &id));
+    REQUIRE(id == 7);
+
+    const char* first = "first";
+    const char* second = "second";
+    char* concat = NULL;
+    void* concatArgs[] = { &first, &second };
+    REQUIRE(mono_embeddinator_invoke_dynamic("Methods_Parameters_Concat", concatArgs, &concat));
+    REQUIRE(strcmp(concat, "firstsecond") == 0);
+
+    // Each name is hashed to its own slot, including the ones whose first hash
+    // collides with other names of the table.
+    const char* names[] = {
+        "Type_Char_get_Min", "Type_Char_get_Max", "Type_SByte_get_Min", "Type_SByte_get_Max",
+        "Type_Byte_get_Min", "Type_Byte_get_Max", "Type_Int16_get_Min", "Type_Int16_get_Max",
+        "Type_Int32_get_Min", "Type_Int32_get_Max", "Type_Int64_get_Min", "Type_Int64_get_Max",
+        "Type_UInt16_get_Min", "Type_UInt16_get_Max", "Type_UInt32_get_Min", "Type_UInt32_get_Max",
+        "Type_UInt64_get_Min", "Type_UInt64_get_Max", "Type_Single_get_Min", "Type_Single_get_Max",
+        "Type_Double_get_Min", "Type_Double_get_Max", "Methods_Static_Create",
+        "Methods_Collection_get_Count", "Hints_Promises_get_SquareCalls",
+    };
+    for (const char* name : names) {
+        const mono_embeddinator_dynamic_entry_t* entry = mono_embeddinator_lookup_dynamic(name);
+        REQUIRE(entry != NULL);
+        REQUIRE(strcmp(entry->name, name) == 0);
+    }
+
+    // Found in the table of the other assembly.
+    const mono_embeddinator_dynamic_entry_t* nested =
+        mono_embeddinator_lookup_dynamic("managed_NestedModuleTest_nestedFunction");
+    REQUIRE(nested != NULL);
+    REQUIRE(nested->function == (void (*)()) managed_NestedModuleTest_nestedFunction);
+
+    REQUIRE(mono_embeddinator_lookup_dynamic("Hints_Promises_Missing") == NULL);
+    REQUIRE(mono_embeddinator_lookup_dynamic("Hints_Promises_Ad") == NULL);
+    REQUIRE(mono_embeddinator_lookup_dynamic("Hints_Promises_Add_") == NULL);
+    REQUIRE(mono_embeddinator_lookup_dynamic("") == NULL);
+    REQUIRE(!mono_embeddinator_invoke_dynamic("Hints_Promises_Missing", addArgs, &sum));
+}
+
 TEST_CASE("FSharpTypes.C", "[C][FSharp Types]") {
     managed_UserRecord* userRecord = managed_UserRecord_new("Test");
     REQUIRE(strcmp(managed_UserRecord_get_UserDescription(userRecord), "Test") == 0);
@@ -0,0 +1,99 @@
+﻿#include <catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "managed.hpp"
+
+// Types without a namespace are qualified to tell them apart from their C declarations.
+using namespace managed;
+
+TEST_CASE("Properties.Cpp", "[Cpp][Properties]") {
+    managed::Platform::set_ExitCode(255);
+    REQUIRE(managed::Platform::get_ExitCode() == 255);
+
+    REQUIRE(Properties::Query::get_UniversalAnswer() == 42);
+
+    Properties::Query prop;
+    REQUIRE(prop.get_IsGood() == true);
+    REQUIRE(prop.get_Answer() == 42);
+    prop.set_Answer(911);
+    REQUIRE(prop.get_Answer() == 911);
+}
+
+TEST_CASE("Namespaces.Cpp", "[Cpp][Namespaces]") {
+    managed::ClassWithoutNamespace nonamespace;
+    REQUIRE(nonamespace.ToString().view() == "ClassWithoutNamespace");
+
+    First::Second::ClassWithNestedNamespace nestednamespaces;
+    REQUIRE(nestednamespaces.ToString().view() == "First.Second.ClassWithNestedNamespace");
+}
+
+TEST_CASE("NestedClasses.Cpp", "[Cpp][NestedClasses]") {
+    NestedClasses::ParentClass parent;
+    REQUIRE(parent.AddNumbers(1, 2) == 3);
+
+    // Nested types are prefixed with the names of their outer types.
+    NestedClasses::ParentClass_NestedClass nested;
+    REQUIRE(nested.Addition(2, 3) == 5);
+}
+
+TEST_CASE("Ownership.Cpp", "[Cpp][Ownership]") {
+    Constructors::Unique unique(911);
+    REQUIRE(unique.get_Id() == 911);
+
+    Constructors::Unique moved = std::move(unique);
+    REQUIRE(!unique);
+    REQUIRE(moved.get_Id() == 911);
+
+    Constructors::SuperUnique super_unique;
+    REQUIRE(super_unique.get_Id() == 411);
+
+    // Constructors that throw leave the wrapper empty.
+    Exceptions::Throwers throwers;
+    REQUIRE(!throwers);
+
+    Constructors::Unique empty(nullptr);
+    REQUIRE(!empty);
+    empty = std::move(moved);
+    REQUIRE(empty.get_Id() == 911);
+}
+
+TEST_CASE("Methods.Cpp", "[Cpp][Methods]") {
+    Methods::Static static_method = Methods::Static::Create(1);
+    REQUIRE(static_method.get_Id() == 1);
+
+    REQUIRE(!Methods::Parameters::Concat(nullptr, nullptr));
+    REQUIRE(Methods::Parameters::Concat("first", nullptr).view() == "first");
+
+    std::string first = "first";
+    std::string_view second = "second";
+    REQUIRE(Methods::Parameters::Concat(first, second).str() == "firstsecond");
+
+    Methods::Collection collection;
+    collection.Add(Methods::Factory::CreateItem(1));
+    REQUIRE(collection.get_Count() == 1);
+    REQUIRE(collection.get_Item(0).get_Integer() == 1);
+}
+
+TEST_CASE("Structs.Cpp", "[Cpp][Structs]") {
+    Structs::Point p1(1.0f, -1.0f);
+    Structs::Point p2(2.0f, -2.0f);
+
+    Structs::Point p3 = Structs::Point::op_Addition(p1, p2);
+    REQUIRE(p3.get_X() == 3.0f);
+    REQUIRE(p3.get_Y() == -3.0f);
+    REQUIRE(Structs::Point::op_Equality(Structs::Point::op_Subtraction(p3, p2), p1) == true);
+}
+
+TEST_CASE("Arrays.Cpp", "[Cpp][Arrays]") {
+    std::vector<uint8_t> bytes = { 1, 2, 3 };
+    REQUIRE(Arrays::Arr::SumByteArray(bytes) == 6);
+
+    uint8_t raw[] = { 4, 5, 6 };
+    REQUIRE(Arrays::Arr::SumByteArray(raw) == 15);
+
+    mono_embeddinator::array<int32_t> ints = Arrays::Arr::ReturnsIntArray();
+    REQUIRE(ints.size() == 3);
+    REQUIRE(std::vector<int32_t>(ints.begin(), ints.end()) == std::vector<int32_t>{ 1, 2, 3 });
+}
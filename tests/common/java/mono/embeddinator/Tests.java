@@ -13,6 +13,7 @@ import managed.abstracts.*;
 import managed.methods.*;
 import managed.structs.*;
 import managed.keywords.*;
+import managed.arrays.*;
 
 import static org.junit.Assert.*;
 import org.junit.*;
@@ -111,10 +112,8 @@ public class Tests {
         AllTypeCode all2 = new AllTypeCode(Byte.MAX_VALUE, Short.MAX_VALUE, Integer.MAX_VALUE, Long.MAX_VALUE);
         assertTrue(all2.getTestResult());
 
-        // TODO: Use BigDecimal for unsigned 64-bit integer types.
-        //AllTypeCode all3 = new AllTypeCode(new UnsignedByte(UCHAR_MAX), new UnsignedShort(USHRT_MAX),
-        //    new UnsignedInt(UINT_MAX), new UnsignedLong(ULONG_MAX));
-        //assertTrue(all3.getTestResult());
+        // The unsigned overload has the same Java signature as the signed one,
+        // so it is not bound.
 
         AllTypeCode all4 = new AllTypeCode(Float.MAX_VALUE, Double.MAX_VALUE);
         assertTrue(all4.getTestResult());
@@ -130,7 +129,7 @@ public class Tests {
         assertEquals("second", Parameters.concat(null, "second"));
         assertEquals("firstsecond", Parameters.concat("first", "second"));
 
-        Ref<Boolean> b = new Ref<Boolean>(true);
+        BoolRef b = new BoolRef(true);
         Ref<java.lang.String> s = new Ref<java.lang.String>(null);
         Parameters.ref(b, s);
         assertFalse(b.get());
@@ -140,30 +139,35 @@ public class Tests {
         assertTrue(b.get());
         assertEquals(null, s.get());
 
-        Ref<UnsignedByte> refUChar = new Ref<UnsignedByte>(new UnsignedByte(1));
+        ByteRef refUChar = new ByteRef((byte) 1);
         Parameters.refUnsignedCharPlusOne(refUChar);
-        assertEquals(2, refUChar.get().intValue());
+        assertEquals(2, refUChar.get());
 
-        Ref<UnsignedShort> refUShort = new Ref<UnsignedShort>(new UnsignedShort(1));
+        // Holders can be reused across calls.
+        refUChar.set((byte) 0xFE);
+        Parameters.refUnsignedCharPlusOne(refUChar);
+        assertEquals(UCHAR_MAX, Byte.toUnsignedInt(refUChar.get()));
+
+        ShortRef refUShort = new ShortRef((short) 1);
         Parameters.refUnsignedShortPlusOne(refUShort);
-        assertEquals(2, refUShort.get().intValue());
+        assertEquals(2, refUShort.get());
 
-        Ref<UnsignedInt> refUInt = new Ref<UnsignedInt>(new UnsignedInt(1));
+        IntRef refUInt = new IntRef(1);
         Parameters.refUnsignedIntPlusOne(refUInt);
-        assertEquals(2, refUInt.get().intValue());
+        assertEquals(2, refUInt.get());
 
-        Ref<UnsignedLong> refULong = new Ref<UnsignedLong>(new UnsignedLong(1));
+        LongRef refULong = new LongRef(1);
         Parameters.refUnsignedLongPlusOne(refULong);
-        assertEquals(2, refULong.get().intValue());
+        assertEquals(2, refULong.get());
 
-        Out<Integer> l = new Out<Integer>();
+        IntOut l = new IntOut();
         Out<java.lang.String> os = new Out<java.lang.String>();
         Parameters.out(null, l, os);
-        assertEquals(new Integer(0), l.get());
+        assertEquals(0, l.get());
         assertEquals(null, os.get());
 
         Parameters.out("Xamarin", l, os);
-        assertEquals(new Integer(7), l.get());
+        assertEquals(7, l.get());
         assertEquals("XAMARIN", os.get());
 
         int refId = Parameters.refClass(new Ref<Static>(static_method));
@@ -263,6 +267,8 @@ public class Tests {
     @Test
     public void testFieldsInReferences() {
         assertEquals(Long.MAX_VALUE, managed.fields.Class.getMaxLong());
+        assertEquals(Long.MAX_VALUE, managed.fields.Class.MaxLong);
+        assertEquals(42, managed.fields.Class.ReadOnlyInteger);
 
         assertEquals(0, managed.fields.Class.getInteger());
         managed.fields.Class.setInteger(1);
@@ -362,18 +368,17 @@ public class Tests {
         assertEquals(Long.MIN_VALUE, Type_Int64.getMin());
         assertEquals(Long.MAX_VALUE, Type_Int64.getMax());
 
-        assertEquals(0, Type_Byte.getMin().longValue());
-        assertEquals(UCHAR_MAX, Type_Byte.getMax().longValue());
+        assertEquals(0, Type_Byte.getMin());
+        assertEquals(UCHAR_MAX, Byte.toUnsignedLong(Type_Byte.getMax()));
 
-        assertEquals(0, Type_UInt16.getMin().longValue());
-        assertEquals(USHRT_MAX, Type_UInt16.getMax().longValue());
+        assertEquals(0, Type_UInt16.getMin());
+        assertEquals(USHRT_MAX, Short.toUnsignedLong(Type_UInt16.getMax()));
 
-        assertEquals(0, Type_UInt32.getMin().longValue());
-        assertEquals(UINT_MAX, Type_UInt32.getMax().longValue());
+        assertEquals(0, Type_UInt32.getMin());
+        assertEquals(UINT_MAX, Integer.toUnsignedLong(Type_UInt32.getMax()));
 
-        assertEquals(0, Type_UInt64.getMin().longValue());
-        // TODO: Use BigDecimal for unsigned 64-bit integer types.
-        //assertEquals(ULONG_MAX, Type_UInt64.getMax().longValue());
+        assertEquals(0, Type_UInt64.getMin());
+        assertEquals("18446744073709551615", Long.toUnsignedString(Type_UInt64.getMax()));
 
         doublesAreEqual(-Float.MAX_VALUE, Type_Single.getMin());
         doublesAreEqual(Float.MAX_VALUE, Type_Single.getMax());
@@ -385,10 +390,30 @@ public class Tests {
         assertEquals(Character.MAX_VALUE, Type_Char.getMax());
         assertEquals(0, Type_Char.getZero());
 
+        assertEquals(Integer.MIN_VALUE, Type_Int32.Min);
+        assertEquals("18446744073709551615", Long.toUnsignedString(Type_UInt64.Max));
+        doublesAreEqual(-Double.MAX_VALUE, Type_Double.Min);
+        assertEquals("Hello World", Type_String.NonEmptyString);
+
         //Just validate this doesn't crash for now
         assertNotNull(Type_DateTime.getNow());
     }
 
+    @Test
+    public void testArrays() {
+        java.nio.IntBuffer ints = Arr.returnsIntArray();
+        assertEquals(3, ints.remaining());
+        assertEquals(1, ints.get(0));
+        assertEquals(3, ints.get(2));
+
+        assertEquals(6, Arr.sumByteArray(new byte[] { 1, 2, 3 }));
+
+        java.nio.ByteBuffer bytes = java.nio.ByteBuffer.allocateDirect(4);
+        bytes.put((byte) 1).put((byte) 2).put((byte) 3).put((byte) 4).flip();
+        bytes.get();
+        assertEquals(9, Arr.sumByteArray(bytes));
+    }
+
     @Test
     public void testKeywords() {
         Keywords keywords = new Keywords();
@@ -0,0 +1,33 @@
+using System;
+
+namespace Callbacks {
+
+	public delegate int Transform (int value);
+
+	public delegate void Visitor (string name, long value);
+
+	public static class Invoker {
+
+		public static int Apply (Transform transform, int value) => transform (value);
+
+		public static int Sum (Transform transform, int count)
+		{
+			var sum = 0;
+			for (int i = 0; i < count; i++)
+				sum += transform (i);
+			return sum;
+		}
+
+		public static void Visit (Visitor visitor)
+		{
+			visitor ("one", 1);
+			visitor ("two", 2);
+		}
+
+		static Transform retained;
+
+		public static void Retain (Transform transform) => retained = transform;
+
+		public static int ApplyRetained (int value) => retained (value);
+	}
+}
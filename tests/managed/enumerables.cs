@@ -0,0 +1,67 @@
+using System;
+using System.Collections.Generic;
+using System.Collections.ObjectModel;
+using System.Linq;
+
+namespace Enumerables {
+
+	public class Item {
+
+		public Item (int value)
+		{
+			Value = value;
+		}
+
+		public int Value { get; private set; }
+	}
+
+	public enum Color {
+		Red,
+		Green,
+		Blue,
+	}
+
+	public static class Collections {
+
+		// copied through List<T>.AddRange
+		public static IEnumerable<int> Range (int count) => Enumerable.Range (0, count);
+
+		// copied through ICollection<T>.CopyTo
+		public static IList<int> List (int count) => Enumerable.Range (0, count).ToList ();
+
+		// read from the array
+		public static IReadOnlyList<long> Longs => new [] { long.MinValue, 0, long.MaxValue };
+
+		public static IEnumerable<Color> Colors => new [] { Color.Red, Color.Green, Color.Blue };
+
+		public static IEnumerable<string> Strings ()
+		{
+			yield return "Hola";
+			yield return null;
+			yield return "Bonjour";
+		}
+
+		// copied through ICollection<T>.CopyTo
+		public static IList<Item> Items (int count) => new Collection<Item> (Enumerable.Range (0, count).Select (i => new Item (i)).ToList ());
+
+		// implements ICollection<string>, copied through IEnumerable<int>
+		public static IEnumerable<int> Lengths => new StringLengths { "a", "bb", "ccc" };
+
+		public static IEnumerable<int> Null => null;
+
+		public static IEnumerable<int> Throws ()
+		{
+			yield return 1;
+			throw new InvalidOperationException ();
+		}
+	}
+
+	class StringLengths : List<string>, IEnumerable<int> {
+
+		IEnumerator<int> IEnumerable<int>.GetEnumerator ()
+		{
+			foreach (var value in (List<string>) this)
+				yield return value.Length;
+		}
+	}
+}
@@ -7,6 +7,8 @@ namespace Fields {
 		// read only
 		public const long MaxLong = Int64.MaxValue;
 
+		public static readonly int ReadOnlyInteger = 42;
+
 		public static Class Scratch = new Class (true);
 
 		// read/write
@@ -0,0 +1,115 @@
+using System;
+
+namespace Embeddinator {
+
+	// The binder matches hint attributes by name, so libraries can declare their own copy.
+	[AttributeUsage (AttributeTargets.Parameter)]
+	sealed class CacheableStringAttribute : Attribute {
+	}
+
+	[AttributeUsage (AttributeTargets.Method | AttributeTargets.Property | AttributeTargets.Constructor)]
+	sealed class NoThrowAttribute : Attribute {
+	}
+
+	[AttributeUsage (AttributeTargets.Method | AttributeTargets.Property)]
+	sealed class PureAttribute : Attribute {
+	}
+
+	[AttributeUsage (AttributeTargets.Method | AttributeTargets.Parameter)]
+	sealed class DoesNotRetainArgumentsAttribute : Attribute {
+	}
+
+	[AttributeUsage (AttributeTargets.Struct)]
+	sealed class BlittableAttribute : Attribute {
+	}
+}
+
+namespace Hints {
+
+	public static class CachedStrings {
+
+		static string last;
+
+		public static string Echo ([Embeddinator.CacheableString] string key)
+		{
+			return key;
+		}
+
+		// to help test the same managed instance is handed out for repeated arguments
+		public static bool IsSameAsLast ([Embeddinator.CacheableString] string key)
+		{
+			var same = object.ReferenceEquals (key, last);
+			last = key;
+			return same;
+		}
+	}
+
+	public static class Promises {
+
+		static int squareCalls;
+
+		// to help test the results of pure methods are reused
+		public static int SquareCalls => squareCalls;
+
+		[Embeddinator.NoThrow]
+		public static int Add (int a, int b)
+		{
+			return a + b;
+		}
+
+		[Embeddinator.Pure]
+		public static int Square (int value)
+		{
+			squareCalls++;
+			return value * value;
+		}
+
+		[Embeddinator.DoesNotRetainArguments]
+		public static int Sum (int[] values)
+		{
+			int sum = 0;
+			foreach (var value in values)
+				sum += value;
+			return sum;
+		}
+	}
+
+	public class Total {
+
+		// to help test the lent arrays are returned when a constructor throws
+		public Total ([Embeddinator.DoesNotRetainArguments] int[] values)
+		{
+			if (values.Length == 0)
+				throw new ArgumentException ("At least one value is needed.", nameof (values));
+
+			foreach (var value in values)
+				Value += value;
+		}
+
+		public int Value { get; }
+	}
+
+	[Embeddinator.Blittable]
+	public struct Size {
+
+		public Size (int width, int height)
+		{
+			Width = width;
+			Height = height;
+		}
+
+		public int Width { get; }
+
+		public int Height { get; }
+
+		public static int Area (Size size)
+		{
+			return size.Width * size.Height;
+		}
+
+		public static Size Scale (Size size, int factor)
+		{
+			return new Size (size.Width * factor, size.Height * factor);
+		}
+	}
+}
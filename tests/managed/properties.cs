@@ -67,6 +67,29 @@ namespace Properties {
 		public Query SetBar() => Bar;
 	}
 
+	// snapshot reading a few values before a getter throws
+	public class Partial {
+
+		bool broken;
+
+		public Partial (bool broken)
+		{
+			this.broken = broken;
+		}
+
+		public string Name => "Partial";
+
+		public Query Query => new Query ();
+
+		public int Value {
+			get {
+				if (broken)
+					throw new InvalidOperationException ();
+				return 42;
+			}
+		}
+	}
+
 	public class DuplicateIndexedProperties {
 		public int this[int i] { get { return 42; } }
 		public int this[string i] { get { return 42; } }
@@ -0,0 +1,46 @@
+using System;
+using System.IO;
+using System.Text;
+
+namespace Streams {
+
+	public static class Source {
+
+		public static Stream Open (string text) => new MemoryStream (Encoding.UTF8.GetBytes (text));
+
+		// larger than a single pooled buffer, to exercise chunking
+		public static Stream OpenLarge (int length)
+		{
+			var data = new byte [length];
+			for (int i = 0; i < length; i++)
+				data [i] = (byte) (i % 251);
+			return new MemoryStream (data);
+		}
+
+		public static Stream CreateBuffer () => new MemoryStream ();
+	}
+
+	public static class Sink {
+
+		public static string ReadAll (Stream stream)
+		{
+			using (var reader = new StreamReader (stream, Encoding.UTF8))
+				return reader.ReadToEnd ();
+		}
+
+		public static long Sum (Stream stream)
+		{
+			long sum = 0;
+			int value;
+			while ((value = stream.ReadByte ()) != -1)
+				sum += value;
+			return sum;
+		}
+
+		public static string Decode (Stream stream)
+		{
+			var memory = stream as MemoryStream;
+			return memory == null ? null : Encoding.UTF8.GetString (memory.ToArray ());
+		}
+	}
+}
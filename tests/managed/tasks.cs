@@ -0,0 +1,39 @@
+using System;
+using System.Threading.Tasks;
+
+namespace Tasks {
+
+	public class Item {
+
+		public Item (string name)
+		{
+			Name = name;
+		}
+
+		public string Name { get; private set; }
+	}
+
+	public static class Async {
+
+		public static Task Delay (int milliseconds) => Task.Delay (milliseconds);
+
+		public static async Task<int> Add (int a, int b)
+		{
+			await Task.Delay (10);
+			return a + b;
+		}
+
+		public static Task<string> Echo (string value) => Task.Run (() => value);
+
+		public static Task<Item> CreateItem (string name) => Task.FromResult (new Item (name));
+
+		public static async Task<int> Throws ()
+		{
+			await Task.Yield ();
+			throw new InvalidOperationException ();
+		}
+
+		// never completes, to help test timeouts
+		public static Task<int> Never => new TaskCompletionSource<int> ().Task;
+	}
+}